@@ -4,25 +4,56 @@
 // Shared Lib Support
 #include "fp/fp_export.h"
 
+// Standard Library Includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+
 // Qt Includes
 #include <QStringList>
 #include <QtSql>
 #include <QColor>
+#include <QFuture>
+#include <QPromise>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QFileSystemWatcher>
+#include <QTimer>
 
 // Qx Includes
 #include <qx/core/qx-abstracterror.h>
 
 // Project Includes
 #include "fp/fp-items.h"
+#include "fp/fp-flathash.h"
 
 using namespace Qt::Literals::StringLiterals;
 
 namespace Fp
 {
 
+class SearchIndex;
+class ChangeTracker;
+class NativeReaderPool;
+class GameView;
+class AddAppView;
+class GameDataView;
+class Snapshot;
+class GameRecordSet;
+class TagIndex;
+class TagDirectory;
+class TestAccess; // Only defined by the tests
+class ConnectionPool;
+class ItemCache;
+class MetadataCache;
+struct PooledConnection;
+
 class FP_FP_EXPORT QX_ERROR_TYPE(DbError, "Fp::DbError", 1101)
 {
     friend class Db;
+    friend class TagIndex;
 //-Class Enums-------------------------------------------------------------
 public:
     enum Type
@@ -32,7 +63,10 @@ public:
         InvalidSchema = 2,
         IdCollision = 3,
         IncompleteSearch = 4,
-        UpdateRowMismatch = 5
+        UpdateRowMismatch = 5,
+        WriteDenied = 6,
+        Unsupported = 7,
+        InvalidExpression = 8
     };
 
 //-Class Variables-------------------------------------------------------------
@@ -44,6 +78,9 @@ private:
         {IdCollision, u"A duplicate of a unique ID was found."_s},
         {IncompleteSearch, u"A data search could not be completed."_s},
         {UpdateRowMismatch, u"An update statement affected a different number of rows than expected."_s},
+        {WriteDenied, u"The database was opened in a mode that does not permit writing."_s},
+        {Unsupported, u"The requested operation is not supported by this build."_s},
+        {InvalidExpression, u"A tag expression could not be evaluated."_s},
     };
 
 //-Instance Variables-------------------------------------------------------------
@@ -78,8 +115,23 @@ public:
     QString details() const;
 };
 
+// Builds a table's column list from its names, see Db::Table_Game
+template<std::size_t N>
+QStringList columnList(const std::array<QStringView, N>& columns)
+{
+    QStringList list;
+    list.reserve(N);
+    for(QStringView column : columns)
+        list.append(column.toString());
+    return list;
+}
+
 class FP_FP_EXPORT Db : public QObject
 {
+    friend class GameView;
+    friend class AddAppView;
+    friend class Snapshot;
+    friend class MetadataCache;
 //-QObject Macro (Required for all QObject Derived Classes)-----------------------------------------------------------
     Q_OBJECT
 
@@ -90,34 +142,41 @@ public:
     public:
         static inline const QString NAME = u"game"_s;
 
-        static inline const QString COL_ID = u"id"_s;
-        static inline const QString COL_PARENT_ID = u"parentGameId"_s;
-        static inline const QString COL_TITLE = u"title"_s;
-        static inline const QString COL_SERIES = u"series"_s;
-        static inline const QString COL_DEVELOPER = u"developer"_s;
-        static inline const QString COL_PUBLISHER = u"publisher"_s;
-        static inline const QString COL_DATE_ADDED = u"dateAdded"_s;
-        static inline const QString COL_DATE_MODIFIED = u"dateModified"_s;
-        static inline const QString COL_BROKEN = u"broken"_s;
-        static inline const QString COL_EXTREME = u"extreme"_s;
-        static inline const QString COL_PLAY_MODE = u"playMode"_s;
-        static inline const QString COL_STATUS = u"status"_s;
-        static inline const QString COL_NOTES = u"notes"_s;
-        static inline const QString COL_SOURCE = u"source"_s;
-        static inline const QString COL_APP_PATH = u"applicationPath"_s;
-        static inline const QString COL_LAUNCH_COMMAND = u"launchCommand"_s;
-        static inline const QString COL_RELEASE_DATE = u"releaseDate"_s;
-        static inline const QString COL_VERSION = u"version"_s;
-        static inline const QString COL_ORIGINAL_DESC = u"originalDescription"_s;
-        static inline const QString COL_LANGUAGE = u"language"_s;
-        static inline const QString COL_LIBRARY = u"library"_s;
-        static inline const QString COL_ORDER_TITLE = u"orderTitle"_s;
-        static inline const QString COL_PLATFORM_NAME = u"platformName"_s;
-        static inline const QString COL_RUFFLE_SUPPORT = u"ruffleSupport"_s;
-
-        static inline const QStringList COLUMN_LIST = {COL_ID, COL_PARENT_ID, COL_TITLE, COL_SERIES, COL_DEVELOPER, COL_PUBLISHER, COL_DATE_ADDED, COL_DATE_MODIFIED,
-                                               COL_BROKEN, COL_EXTREME, COL_PLAY_MODE, COL_STATUS, COL_NOTES, COL_SOURCE, COL_APP_PATH, COL_LAUNCH_COMMAND, COL_RELEASE_DATE,
-                                               COL_VERSION, COL_ORIGINAL_DESC, COL_LANGUAGE, COL_LIBRARY, COL_ORDER_TITLE, COL_PLATFORM_NAME, COL_RUFFLE_SUPPORT};
+        // Positions within COLUMN_LIST, and so within results that select it in full
+        enum Ordinal { ORD_ID, ORD_PARENT_ID, ORD_TITLE, ORD_SERIES, ORD_DEVELOPER, ORD_PUBLISHER, ORD_DATE_ADDED, ORD_DATE_MODIFIED, ORD_BROKEN, ORD_EXTREME,
+                         ORD_PLAY_MODE, ORD_STATUS, ORD_NOTES, ORD_SOURCE, ORD_APP_PATH, ORD_LAUNCH_COMMAND, ORD_RELEASE_DATE, ORD_VERSION, ORD_ORIGINAL_DESC,
+                         ORD_LANGUAGE, ORD_LIBRARY, ORD_ORDER_TITLE, ORD_PLATFORM_NAME, ORD_RUFFLE_SUPPORT, ORD_COUNT };
+        static constexpr std::array<QStringView, ORD_COUNT> COLUMNS{u"id", u"parentGameId", u"title", u"series", u"developer", u"publisher", u"dateAdded",
+            u"dateModified", u"broken", u"extreme", u"playMode", u"status", u"notes", u"source", u"applicationPath", u"launchCommand", u"releaseDate",
+            u"version", u"originalDescription", u"language", u"library", u"orderTitle", u"platformName", u"ruffleSupport"};
+
+        static inline const QString COL_ID = COLUMNS[ORD_ID].toString();
+        static inline const QString COL_PARENT_ID = COLUMNS[ORD_PARENT_ID].toString();
+        static inline const QString COL_TITLE = COLUMNS[ORD_TITLE].toString();
+        static inline const QString COL_SERIES = COLUMNS[ORD_SERIES].toString();
+        static inline const QString COL_DEVELOPER = COLUMNS[ORD_DEVELOPER].toString();
+        static inline const QString COL_PUBLISHER = COLUMNS[ORD_PUBLISHER].toString();
+        static inline const QString COL_DATE_ADDED = COLUMNS[ORD_DATE_ADDED].toString();
+        static inline const QString COL_DATE_MODIFIED = COLUMNS[ORD_DATE_MODIFIED].toString();
+        static inline const QString COL_BROKEN = COLUMNS[ORD_BROKEN].toString();
+        static inline const QString COL_EXTREME = COLUMNS[ORD_EXTREME].toString();
+        static inline const QString COL_PLAY_MODE = COLUMNS[ORD_PLAY_MODE].toString();
+        static inline const QString COL_STATUS = COLUMNS[ORD_STATUS].toString();
+        static inline const QString COL_NOTES = COLUMNS[ORD_NOTES].toString();
+        static inline const QString COL_SOURCE = COLUMNS[ORD_SOURCE].toString();
+        static inline const QString COL_APP_PATH = COLUMNS[ORD_APP_PATH].toString();
+        static inline const QString COL_LAUNCH_COMMAND = COLUMNS[ORD_LAUNCH_COMMAND].toString();
+        static inline const QString COL_RELEASE_DATE = COLUMNS[ORD_RELEASE_DATE].toString();
+        static inline const QString COL_VERSION = COLUMNS[ORD_VERSION].toString();
+        static inline const QString COL_ORIGINAL_DESC = COLUMNS[ORD_ORIGINAL_DESC].toString();
+        static inline const QString COL_LANGUAGE = COLUMNS[ORD_LANGUAGE].toString();
+        static inline const QString COL_LIBRARY = COLUMNS[ORD_LIBRARY].toString();
+        static inline const QString COL_ORDER_TITLE = COLUMNS[ORD_ORDER_TITLE].toString();
+        static inline const QString COL_PLATFORM_NAME = COLUMNS[ORD_PLATFORM_NAME].toString();
+        static inline const QString COL_RUFFLE_SUPPORT = COLUMNS[ORD_RUFFLE_SUPPORT].toString();
+        static inline const QString COL_ALTERNATE_TITLES = u"alternateTitles"_s; // Only used for searching, and optional
+
+        static inline const QStringList COLUMN_LIST = columnList(COLUMNS);
 
         static inline const QString ENTRY_GAME_LIBRARY = u"arcade"_s;
         static inline const QString ENTRY_ANIM_LIBRARY = u"theatre"_s;
@@ -129,21 +188,25 @@ public:
     public:
         static inline const QString NAME = u"game_data"_s;
 
-        static inline const QString COL_ID = u"id"_s;
-        static inline const QString COL_GAME_ID = u"gameId"_s;
-        static inline const QString COL_TITLE = u"title"_s;
-        static inline const QString COL_DATE_ADDED = u"dateAdded"_s;
-        static inline const QString COL_SHA256 = u"sha256"_s;
-        static inline const QString COL_CRC32 = u"crc32"_s;
-        static inline const QString COL_PRES_ON_DISK = u"presentOnDisk"_s;
-        static inline const QString COL_PATH = u"path"_s;
-        static inline const QString COL_SIZE = u"size"_s;
-        static inline const QString COL_PARAM = u"parameters"_s;
-        static inline const QString COL_APP_PATH = u"applicationPath"_s;
-        static inline const QString COL_LAUNCH_COMMAND = u"launchCommand"_s;
-
-        static inline const QStringList COLUMN_LIST = {COL_ID, COL_GAME_ID, COL_TITLE, COL_DATE_ADDED, COL_SHA256, COL_CRC32, COL_PRES_ON_DISK, COL_PATH, COL_SIZE, COL_PARAM,
-                                                      COL_APP_PATH, COL_LAUNCH_COMMAND};
+        enum Ordinal { ORD_ID, ORD_GAME_ID, ORD_TITLE, ORD_DATE_ADDED, ORD_SHA256, ORD_CRC32, ORD_PRES_ON_DISK, ORD_PATH, ORD_SIZE, ORD_PARAM, ORD_APP_PATH,
+                         ORD_LAUNCH_COMMAND, ORD_COUNT };
+        static constexpr std::array<QStringView, ORD_COUNT> COLUMNS{u"id", u"gameId", u"title", u"dateAdded", u"sha256", u"crc32", u"presentOnDisk", u"path",
+            u"size", u"parameters", u"applicationPath", u"launchCommand"};
+
+        static inline const QString COL_ID = COLUMNS[ORD_ID].toString();
+        static inline const QString COL_GAME_ID = COLUMNS[ORD_GAME_ID].toString();
+        static inline const QString COL_TITLE = COLUMNS[ORD_TITLE].toString();
+        static inline const QString COL_DATE_ADDED = COLUMNS[ORD_DATE_ADDED].toString();
+        static inline const QString COL_SHA256 = COLUMNS[ORD_SHA256].toString();
+        static inline const QString COL_CRC32 = COLUMNS[ORD_CRC32].toString();
+        static inline const QString COL_PRES_ON_DISK = COLUMNS[ORD_PRES_ON_DISK].toString();
+        static inline const QString COL_PATH = COLUMNS[ORD_PATH].toString();
+        static inline const QString COL_SIZE = COLUMNS[ORD_SIZE].toString();
+        static inline const QString COL_PARAM = COLUMNS[ORD_PARAM].toString();
+        static inline const QString COL_APP_PATH = COLUMNS[ORD_APP_PATH].toString();
+        static inline const QString COL_LAUNCH_COMMAND = COLUMNS[ORD_LAUNCH_COMMAND].toString();
+
+        static inline const QStringList COLUMN_LIST = columnList(COLUMNS);
     };
 
     class Table_Game_Redirect
@@ -151,10 +214,13 @@ public:
     public:
         static inline const QString NAME = u"game_redirect"_s;
 
-        static inline const QString COL_ID = u"id"_s;
-        static inline const QString COL_SOURCE_ID = u"sourceId"_s;
+        enum Ordinal { ORD_ID, ORD_SOURCE_ID, ORD_COUNT };
+        static constexpr std::array<QStringView, ORD_COUNT> COLUMNS{u"id", u"sourceId"};
+
+        static inline const QString COL_ID = COLUMNS[ORD_ID].toString();
+        static inline const QString COL_SOURCE_ID = COLUMNS[ORD_SOURCE_ID].toString();
 
-        static inline const QStringList COLUMN_LIST = {COL_ID, COL_SOURCE_ID};
+        static inline const QStringList COLUMN_LIST = columnList(COLUMNS);
     };
 
 
@@ -163,15 +229,19 @@ public:
     public:
         static inline const QString NAME = u"additional_app"_s;
 
-        static inline const QString COL_ID = u"id"_s;
-        static inline const QString COL_APP_PATH = u"applicationPath"_s;
-        static inline const QString COL_AUTORUN = u"autoRunBefore"_s;
-        static inline const QString COL_LAUNCH_COMMAND = u"launchCommand"_s;
-        static inline const QString COL_NAME = u"name"_s;
-        static inline const QString COL_WAIT_EXIT = u"waitForExit"_s;
-        static inline const QString COL_PARENT_ID = u"parentGameId"_s;
+        enum Ordinal { ORD_ID, ORD_APP_PATH, ORD_AUTORUN, ORD_LAUNCH_COMMAND, ORD_NAME, ORD_WAIT_EXIT, ORD_PARENT_ID, ORD_COUNT };
+        static constexpr std::array<QStringView, ORD_COUNT> COLUMNS{u"id", u"applicationPath", u"autoRunBefore", u"launchCommand", u"name", u"waitForExit",
+            u"parentGameId"};
 
-        static inline const QStringList COLUMN_LIST = {COL_ID, COL_APP_PATH, COL_AUTORUN, COL_LAUNCH_COMMAND, COL_NAME, COL_WAIT_EXIT, COL_PARENT_ID};
+        static inline const QString COL_ID = COLUMNS[ORD_ID].toString();
+        static inline const QString COL_APP_PATH = COLUMNS[ORD_APP_PATH].toString();
+        static inline const QString COL_AUTORUN = COLUMNS[ORD_AUTORUN].toString();
+        static inline const QString COL_LAUNCH_COMMAND = COLUMNS[ORD_LAUNCH_COMMAND].toString();
+        static inline const QString COL_NAME = COLUMNS[ORD_NAME].toString();
+        static inline const QString COL_WAIT_EXIT = COLUMNS[ORD_WAIT_EXIT].toString();
+        static inline const QString COL_PARENT_ID = COLUMNS[ORD_PARENT_ID].toString();
+
+        static inline const QStringList COLUMN_LIST = columnList(COLUMNS);
 
         static inline const QString ENTRY_EXTRAS = u":extras:"_s;
         static inline const QString ENTRY_MESSAGE = u":message:"_s;
@@ -183,10 +253,13 @@ public:
     public:
         static inline const QString NAME = u"game_tags_tag"_s;
 
-        static inline const QString COL_GAME_ID = u"gameId"_s;
-        static inline const QString COL_TAG_ID = u"tagId"_s;
+        enum Ordinal { ORD_GAME_ID, ORD_TAG_ID, ORD_COUNT };
+        static constexpr std::array<QStringView, ORD_COUNT> COLUMNS{u"gameId", u"tagId"};
+
+        static inline const QString COL_GAME_ID = COLUMNS[ORD_GAME_ID].toString();
+        static inline const QString COL_TAG_ID = COLUMNS[ORD_TAG_ID].toString();
 
-        static inline const QStringList COLUMN_LIST = {COL_GAME_ID, COL_TAG_ID};
+        static inline const QStringList COLUMN_LIST = columnList(COLUMNS);
     };
 
     class Table_Tag
@@ -194,11 +267,14 @@ public:
     public:
         static inline const QString NAME = u"tag"_s;
 
-        static inline const QString COL_ID = u"id"_s;
-        static inline const QString COL_PRIMARY_ALIAS_ID = u"primaryAliasId"_s;
-        static inline const QString COL_CATEGORY_ID = u"categoryId"_s;
+        enum Ordinal { ORD_ID, ORD_PRIMARY_ALIAS_ID, ORD_CATEGORY_ID, ORD_COUNT };
+        static constexpr std::array<QStringView, ORD_COUNT> COLUMNS{u"id", u"primaryAliasId", u"categoryId"};
 
-        static inline const QStringList COLUMN_LIST = {COL_ID, COL_PRIMARY_ALIAS_ID, COL_CATEGORY_ID};
+        static inline const QString COL_ID = COLUMNS[ORD_ID].toString();
+        static inline const QString COL_PRIMARY_ALIAS_ID = COLUMNS[ORD_PRIMARY_ALIAS_ID].toString();
+        static inline const QString COL_CATEGORY_ID = COLUMNS[ORD_CATEGORY_ID].toString();
+
+        static inline const QStringList COLUMN_LIST = columnList(COLUMNS);
     };
 
     class Table_Tag_Alias
@@ -206,11 +282,14 @@ public:
     public:
         static inline const QString NAME = u"tag_alias"_s;
 
-        static inline const QString COL_ID = u"id"_s;
-        static inline const QString COL_TAG_ID = u"tagId"_s;
-        static inline const QString COL_NAME = u"name"_s;
+        enum Ordinal { ORD_ID, ORD_TAG_ID, ORD_NAME, ORD_COUNT };
+        static constexpr std::array<QStringView, ORD_COUNT> COLUMNS{u"id", u"tagId", u"name"};
+
+        static inline const QString COL_ID = COLUMNS[ORD_ID].toString();
+        static inline const QString COL_TAG_ID = COLUMNS[ORD_TAG_ID].toString();
+        static inline const QString COL_NAME = COLUMNS[ORD_NAME].toString();
 
-        static inline const QStringList COLUMN_LIST = {COL_ID, COL_TAG_ID, COL_NAME};
+        static inline const QStringList COLUMN_LIST = columnList(COLUMNS);
     };
 
     class Table_Tag_Category
@@ -218,17 +297,69 @@ public:
     public:
         static inline const QString NAME = u"tag_category"_s;
 
-        static inline const QString COL_ID = u"id"_s;
-        static inline const QString COL_NAME = u"name"_s;
-        static inline const QString COL_COLOR = u"color"_s;
+        enum Ordinal { ORD_ID, ORD_NAME, ORD_COLOR, ORD_COUNT };
+        static constexpr std::array<QStringView, ORD_COUNT> COLUMNS{u"id", u"name", u"color"};
 
-        static inline const QStringList COLUMN_LIST = {COL_ID, COL_NAME, COL_COLOR};
+        static inline const QString COL_ID = COLUMNS[ORD_ID].toString();
+        static inline const QString COL_NAME = COLUMNS[ORD_NAME].toString();
+        static inline const QString COL_COLOR = COLUMNS[ORD_COLOR].toString();
 
+        static inline const QStringList COLUMN_LIST = columnList(COLUMNS);
+    };
+
+    class FP_FP_EXPORT QueryBuffer
+    {
+        friend class Db;
+    //-Instance Variables--------------------------------------------------------------------------------------------
+    private:
+        std::shared_ptr<PooledConnection> mConnection; // Must outlive mResult
+        QString mSource;
+        QSqlQuery mResult;
+        bool mFirstPending;
+        bool mOnRecord;
+        int mVisited;
+
+        // Size is only determined when requested
+        QString mSizeCommand;
+        QVariantMap mSizeBindings;
+        mutable std::optional<int> mSize;
+
+    //-Constructor---------------------------------------------------------------------------------------------------
+    public:
+        QueryBuffer();
+        QueryBuffer(const QueryBuffer& other) = default; // Shares the cursor like a copied QSqlQuery, and keeps the connection leased
+        QueryBuffer(QueryBuffer&& other) = default;
+
+    //-Instance Functions--------------------------------------------------------------------------------------------
+    private:
+        void setResult(const std::shared_ptr<PooledConnection>& connection, const QString& source, QSqlQuery&& result,
+                       const QString& sizeCommand, const QVariantMap& sizeBindings = {});
+
+    public:
+        void swap(QueryBuffer& other) noexcept;
+
+    public:
+        bool isNull() const;
+        bool isEmpty() const;
+        bool isValid() const;
+        QString source() const;
+        DbError size(int& resultBuffer) const; // Counted on first call if the result hasn't been walked to its end
+
+        bool next();
+        QVariant value(int index) const;
+        QVariant value(const QString& name) const;
+        QSqlRecord record() const;
+
+    //-Operators-----------------------------------------------------------------------------------------------------
+    public:
+        QueryBuffer& operator=(const QueryBuffer& other);
+        QueryBuffer& operator=(QueryBuffer&& other) noexcept;
     };
 
     class Key
     {
         friend class Install;
+        friend class TestAccess;
     private:
         Key() {};
         Key(const Key&) = default;
@@ -248,17 +379,6 @@ private:
     };
 
 public:
-    /* TODO: Make this a proper class that abstracts away the direct interactions with the database.
-     * Automatically advance to the first record, have a hasNext() like function, size() function,
-     * direct value() function, etc.
-     */
-    struct QueryBuffer
-    {
-        QString source;
-        QSqlQuery result;
-        int size = 0;
-    };
-
     struct Tag
     {
         int id;
@@ -275,12 +395,85 @@ public:
         friend bool operator< (const TagCategory& lhs, const TagCategory& rhs) noexcept;
     };
 
+private:
+    struct Metadata
+    {
+        QStringList platformNames;
+        QStringList playlistList;
+        std::shared_ptr<const TagDirectory> tagDirectory; // Never null
+        FlatHash<QUuid, QUuid> gameRedirects; // Source -> End of its chain
+
+        // Content hashes of the tables a part was built from, absent when not built here (e.g. loaded from the cache)
+        std::optional<size_t> tagsFingerprint;
+        std::optional<size_t> redirectsFingerprint;
+
+        Metadata();
+    };
+
+    // Queued work that a waiter runs itself if no worker got to it yet, so waiting from a worker can't deadlock
+    struct Phase
+    {
+        std::function<void()> work;
+        std::atomic_flag claimed;
+        QSemaphore done;
+    };
+
+public:
     struct InclusionOptions
     {
         QSet<int> excludedTagIds = {};
         bool includeAnimations = {};
     };
 
+    template<typename T>
+    struct AsyncResult
+    {
+        DbError error;
+        T value = {};
+    };
+
+    struct StatementCacheStats
+    {
+        quint64 hits;
+        quint64 misses;
+    };
+
+    struct BulkProgress
+    {
+        qsizetype chunk; // 1 based
+        qsizetype chunkCount;
+        qsizetype processed;
+        qsizetype total;
+        int expected; // Rows in this chunk
+        int affected;
+    };
+    using BulkProgressHandler = std::function<void(const BulkProgress&)>; // Runs inside the write transaction
+
+    struct ItemCacheStats
+    {
+        quint64 hits;
+        quint64 misses;
+        qsizetype items;
+        qsizetype bytes; // Estimated
+        qsizetype capacity;
+    };
+
+    struct ConnectionProfile
+    {
+        bool readOnly = false; // Open read connections with SQLITE_OPEN_READONLY
+        bool immutable = false; // Assume the file never changes while open; disables writing entirely
+        bool queryOnly = false; // Reject writes issued through read connections
+        bool tempStoreMemory = false;
+        qint64 mmapSize = 0; // Bytes, 0 disables memory-mapped I/O
+        int cacheSize = 0; // KiB per connection, 0 keeps SQLite's default
+        int maxConnections = 8; // Concurrent read connections, split evenly between callers and background work
+        std::chrono::milliseconds idleTimeout = std::chrono::minutes(2); // Before an unused read connection is closed
+        QString metadataCachePath = {}; // Where metadata is persisted between runs, empty disables the cache
+        bool deferMetadata = false; // Load metadata in the background instead of during construction, first use waits for it
+
+        static ConnectionProfile readOptimized();
+    };
+
     struct EntryFilter
     {
         EntryType type = EntryType::PrimaryThenAddApp;
@@ -289,6 +482,7 @@ public:
         QString name = {};
         bool playableOnly = false;
         bool exactName = true;
+        int limit = -1;
     };
 
 //-Class Variables-----------------------------------------------------------------------------------------------
@@ -308,6 +502,12 @@ private:
         {Db::Table_Game_Redirect::NAME, Db::Table_Game_Redirect::COLUMN_LIST},
     };
     static inline const QString GENERAL_QUERY_SIZE_COMMAND = u"COUNT(1)"_s;
+    static constexpr int STATEMENT_CACHE_CAPACITY = 64;
+    static constexpr int BULK_WRITE_CHUNK_SIZE = 5000;
+    static constexpr int MAX_REDIRECT_HOPS = 8; // Chains are expected to be short, this only guards against cycles
+    static inline const QString REDIRECT_TARGET = u"redirect_target"_s;
+    static constexpr int REFRESH_DEBOUNCE_MS = 500;
+    static inline const QString WAL_SUFFIX = u"-wal"_s;
 
     static inline const QString GAME_ONLY_FILTER = Db::Table_Game::COL_LIBRARY + u" = '"_s + Db::Table_Game::ENTRY_GAME_LIBRARY + u"'"_s;
     static inline const QString ANIM_ONLY_FILTER = Db::Table_Game::COL_LIBRARY + u" = '"_s + Db::Table_Game::ENTRY_ANIM_LIBRARY + u"'"_s;
@@ -318,6 +518,9 @@ private:
     static inline const QString ERR_TABLE_MISSING_COLUMN = u"The Flashpoint database tables are missing expected columns."_s;
     static inline const QString ERR_ID_NOT_FOUND = u"An entry matching the specified ID could not be found in the Flashpoint database."_s;
     static inline const QString ERR_ID_DUPLICATE_ENTRY = u"This should not be possible and may indicate an error within the Flashpoint database"_s;
+    static inline const QString ERR_IMMUTABLE_WRITE = u"The database connection profile marks the database as immutable."_s;
+    static inline const QString ERR_NO_SIZE_COMMAND = u"The size of this result can only be determined by walking it."_s;
+    static inline const QString ERR_NO_SIZE_RESULT = u"The size query did not return a count."_s;
 
 //-Instance Variables-----------------------------------------------------------------------------------------------
 private:
@@ -325,76 +528,252 @@ private:
     DbError mError;
 
     // Database information
-    QSet<const QThread*> mConnectedThreads;
+    std::shared_ptr<ConnectionPool> mConnectionPool;
+    std::shared_ptr<ConnectionPool> mWorkerPool; // Used by threads of mWorkers
     const QString mDatabaseName;
-    QStringList mPlatformNames;
-    QStringList mPlaylistList;
-    QMap<int, TagCategory> mTagDirectory; // Tag category id -> Tag category
-    QHash<int, const Tag*> mTagMap; // Tag id -> Tag
-    QHash<QUuid, QUuid> mGameRedirects;
+    const ConnectionProfile mProfile;
+    std::shared_ptr<const Metadata> mMetadata; // Replaced as a whole on refresh, never modified
+    mutable QMutex mMetadataMutex; // Only held to copy or swap the pointer, or to finish a deferred load
+    mutable std::shared_ptr<Phase> mMetadataLoad; // Pending deferred load
+    DbError mMetadataError; // Result of the deferred load
+
+    // Change detection
+    QMutex mRefreshMutex;
+    std::unique_ptr<ChangeTracker> mChangeTracker; // Null for immutable databases
+    std::optional<quint64> mMetadataGeneration; // Data generation the current metadata was read at
+    std::unique_ptr<MetadataCache> mMetadataCache; // Null when disabled
+    QFileSystemWatcher mFileWatcher;
+    QTimer mRefreshTimer;
+
+    // Writing
+    std::shared_ptr<ConnectionPool> mWritePool;
+    QMutex mWriteMutex; // Serializes writes across threads
+
+    // Statement caching
+    std::atomic<quint64> mStatementCacheHits;
+    std::atomic<quint64> mStatementCacheMisses;
+
+    // Item caching
+    std::unique_ptr<ItemCache> mItemCache;
+
+    // Async
+    QThreadPool mWorkers;
+
+    // Bulk
+    std::shared_ptr<NativeReaderPool> mNativeReaders; // Null without the native backend
+
+    // Search
+    std::shared_ptr<SearchIndex> mSearchIndex;
+    QString mSearchIndexPath;
+    QMutex mSearchIndexMutex;
+    quint64 mSearchIndexGeneration;
+
+    // Tag filtering
+    std::shared_ptr<const TagIndex> mTagIndex;
+    QMutex mTagIndexMutex;
 
 //-Constructor-------------------------------------------------------------------------------------------------
 public:
-    explicit Db(const QString& databaseName, const Key&);
+    explicit Db(const QString& databaseName, const ConnectionProfile& profile, const Key&);
 
 //-Destructor-------------------------------------------------------------------------------------------------
 public:
     ~Db();
 
+//-Class Functions--------------------------------------------------------------------------------------------------------
+private:
+    static QString idSetJson(const QList<QUuid>& ids);
+    static QString idSetFilter(const QString& column, const QString& placeholder);
+    static QString redirectCte(const QString& placeholder);
+    static QString redirectedIdSetFilter(const QString& column, const QString& placeholder);
+    static QString makeGameFilter(QVariantMap& bindingsBuffer, const InclusionOptions& inclusionOptions, std::optional<const QList<QUuid>*> idInclusionFilter);
+    static QString singleLine(QString text);
+    static Game buildGame(const QueryBuffer& buffer, int offset = 0);
+    static AddApp buildAddApp(const QueryBuffer& buffer, int offset = 0);
+    static GameData buildGameData(const QueryBuffer& buffer, int offset = 0);
+    static Entry buildPolymorphicEntry(const QueryBuffer& buffer);
+
 //-Instance Functions------------------------------------------------------------------------------------------------------
 private:
     // Validity
     void nullify();
 
     // Connection
-    void closeConnection(const QThread* thread);
-    void closeAllConnections();
-    QString threadConnectionName(const QThread* thread);
-    QSqlError getThreadConnection(QSqlDatabase& connection);
-    QSqlError makeNonBindQuery(QueryBuffer& resultBuffer, QSqlDatabase* database, const QString& queryCommand, const QString& sizeQueryCommand) const;
+    QString connectionNamePrefix() const;
+    QSqlError openConnection(QSqlDatabase& connection, const QString& connectionName, bool write);
+    QSqlError getConnection(std::shared_ptr<PooledConnection>& connection);
+    QSqlError getWriteConnection(std::shared_ptr<PooledConnection>& connection);
+
+    // Search
+    std::shared_ptr<SearchIndex> searchIndex();
+
+    // Item caching
+    void checkItemCacheCoherency();
+
+    // Async
+    void startWork(std::function<void()> work);
+    std::shared_ptr<Phase> startPhase(std::function<void()> work);
+    static void finishPhase(Phase& phase);
+    void runPhases(const QList<std::function<void()>>& phases);
+
+    template<typename T, typename Task>
+    QFuture<AsyncResult<T>> runAsync(Task&& task)
+    {
+        /* Task signature: DbError(T& resultBuffer). Results must be plain values, anything tied to a connection (like
+         * a QueryBuffer) would end up being used from a thread other than the one the connection belongs to.
+         */
+        static_assert(!std::is_same_v<T, QueryBuffer>, "Async results must be materialized on the worker");
+        auto promise = std::make_shared<QPromise<AsyncResult<T>>>();
+        QFuture<AsyncResult<T>> future = promise->future();
+        promise->start();
+
+        startWork([promise, task = std::forward<Task>(task)]() mutable {
+            if(!promise->isCanceled())
+            {
+                AsyncResult<T> result;
+                result.error = task(result.value);
+                promise->addResult(std::move(result));
+            }
+
+            promise->finish();
+        });
+
+        return future;
+    }
+
+    // Statements
+    QSqlError prepareStatement(QSqlQuery& statement, PooledConnection& connection, const QString& command);
+    void recycleStatement(QSqlQuery& statement, PooledConnection& connection);
+    void recycleStatement(QueryBuffer& buffer);
+    QSqlError makeQuery(QueryBuffer& resultBuffer, const std::shared_ptr<PooledConnection>& connection, const QString& source, const QString& queryCommand,
+                        const QString& sizeQueryCommand, const QVariantMap& bindings = {});
+
+    // Queries
+#ifdef FP_NATIVE_SQLITE
+    template<class View>
+    DbError forEachRow(const QString& command, const std::function<bool(const View&)>& visitor);
+#endif
+    DbError queryEntriesById(QueryBuffer& resultBuffer, const QList<QUuid>& ids, bool followRedirects, int limit = -1);
 
     // Init
     QSqlError checkDatabaseForRequiredTables(QSet<QString>& missingTablesBuffer);
     QSqlError checkDatabaseForRequiredColumns(QSet<QString>& missingColumsBuffer);
-    QSqlError populateAvailableItems();
-    QSqlError populateTags();
-    QSqlError populateGameRedirects();
+    DbError validateSchema();
+    QSqlError populateAvailableItems(Metadata& metadata);
+    static QSqlError tableFingerprint(size_t& resultBuffer, QSqlDatabase& connection, const QString& table, const QStringList& columns);
+    QSqlError populateTags(Metadata& metadata, const Metadata* previous);
+    QSqlError populateGameRedirects(Metadata& metadata, const Metadata* previous);
+    QSqlError populateMetadata(std::shared_ptr<const Metadata>& metadata, const Metadata* previous = nullptr);
+
+    // Metadata
+    std::shared_ptr<const Metadata> metadata() const; // Empty if loading failed, for uses that can do without
+    DbError metadata(std::shared_ptr<const Metadata>& resultBuffer) const;
+    void finishMetadataLoad() const;
+    std::optional<quint64> dataGeneration();
+    void watchFiles();
 
 public:
     // Validity
     bool isValid();
     DbError error();
 
+    // Connection
+    void closeIdleConnections();
+
     // TODO: See if these query functions can be consolidated via by better filtration arguments
 
     // Queries - OFLIb
-    DbError queryGamesByPlatform(QList<Db::QueryBuffer>& resultBuffer, const QStringList& platforms, const InclusionOptions& inclusionOptions,
-                                   std::optional<const QList<QUuid>*> idInclusionFilter = std::nullopt);
+    DbError queryGamesByPlatform(std::vector<QueryBuffer>& resultBuffer, const QStringList& platforms, const InclusionOptions& inclusionOptions,
+                                 std::optional<const QList<QUuid>*> idInclusionFilter = std::nullopt);
+    DbError queryGamesByPlatform(QList<QueryBuffer>& resultBuffer, const QStringList& platforms, const InclusionOptions& inclusionOptions,
+                                 std::optional<const QList<QUuid>*> idInclusionFilter = std::nullopt);
+    DbError queryGamesByPlatform(QueryBuffer& resultBuffer, const QStringList& platforms, const InclusionOptions& inclusionOptions,
+                                 std::optional<const QList<QUuid>*> idInclusionFilter = std::nullopt);
     DbError queryAllAddApps(QueryBuffer& resultBuffer);
     DbError queryAllEntryTags(QueryBuffer& resultBuffer);
 
+    // Queries - Tags
+    DbError tagIndex(std::shared_ptr<const TagIndex>& resultBuffer);
+    DbError queryGameIdsByTagExpression(QList<QUuid>& resultBuffer, const QString& expression);
+
+    // Queries - Search
+    DbError searchEntrys(QList<QUuid>& resultBuffer, const QString& text, int limit = -1);
+
     // Queries - CLIFp
     DbError queryEntrys(QueryBuffer& resultBuffer, const EntryFilter& filter);
     DbError queryEntryDataById(QueryBuffer& resultBuffer, const QUuid& appId);
     DbError queryAllGameIds(QueryBuffer& resultBuffer, const LibraryFilter& filter);
 
     // Info
-    QStringList platformNames() const;
-    QMap<int, TagCategory> tags() const;
+    ConnectionProfile connectionProfile() const;
+    QStringList platformNames() const; // Empty, with a warning, if metadata failed to load
+    DbError platformNames(QStringList& resultBuffer) const;
+    std::shared_ptr<const TagDirectory> tagDirectory() const;
+    DbError tagDirectory(std::shared_ptr<const TagDirectory>& resultBuffer) const;
+    QMap<int, TagCategory> tags() const; // Nested layout, built once per directory, prefer tagDirectory()
+    DbError tags(QMap<int, TagCategory>& resultBuffer) const;
+    StatementCacheStats statementCacheStats() const;
+    ItemCacheStats itemCacheStats() const;
 
     // Checks
     DbError entryUsesDataPack(bool& resultBuffer, const QUuid& gameId);
 
     // Helper
     DbError getEntry(Entry& entry, const QUuid& entryId);
+    DbError getEntries(QHash<QUuid, Entry>& entries, const QList<QUuid>& entryIds);
     DbError getGameData(GameData& data, const QUuid& gameId);
+    DbError getGameDataBatch(QHash<QUuid, GameData>& data, const QList<QUuid>& gameIds);
     DbError getGameTags(GameTags& tags, const QUuid& gameId);
-    DbError updateGameDataOnDiskState(QList<int> packIds, bool onDisk);
+    DbError getGameTagsBatch(QHash<QUuid, GameTags>& tags, const QList<QUuid>& gameIds);
+    DbError forEachEntryTag(const std::function<bool(const QUuid&, const Tag&)>& visitor, std::optional<const QList<QUuid>*> gameIdFilter = std::nullopt);
+    DbError updateGameDataOnDiskState(const QList<int>& packIds, bool onDisk, const BulkProgressHandler& progress = {},
+                                      int chunkSize = BULK_WRITE_CHUNK_SIZE);
     QUuid handleGameRedirects(const QUuid& gameId);
 
-//-Slots ------------------------------------------------------------------------------------------------------
-private:
-    void connectedThreadDestroyed(QObject* thread);
+    // Metadata
+    DbError waitForMetadata();
+    DbError refreshMetadata(bool force = false);
+    void setAutoRefresh(bool enabled);
+
+    // Item caching, disabled (0 bytes) by default. Each cached lookup first checks the database for commits
+    void setItemCacheCapacity(qsizetype bytes);
+    void clearItemCache();
+
+    // Search
+    void setSearchIndexPath(const QString& path);
+    DbError updateSearchIndex();
+
+    // Bulk - Native, visitors return false to stop early
+    static bool hasNativeBackend();
+#ifdef FP_NATIVE_SQLITE
+    DbError forEachGame(const std::function<bool(const GameView&)>& visitor, const LibraryFilter& filter = LibraryFilter::Either);
+    DbError forEachAddApp(const std::function<bool(const AddAppView&)>& visitor);
+    DbError forEachGameData(const std::function<bool(const GameDataView&)>& visitor);
+#endif
+
+    // Bulk - Snapshot
+    DbError snapshot(std::shared_ptr<const Snapshot>& resultBuffer);
+
+    // Bulk - Game records
+    DbError gameRecords(std::shared_ptr<const GameRecordSet>& resultBuffer, const LibraryFilter& filter = LibraryFilter::Either,
+                        bool includeLongText = true);
+
+    // Async
+    QFuture<AsyncResult<QList<Game>>> queryGamesByPlatformAsync(const QStringList& platforms, const InclusionOptions& inclusionOptions,
+                                                                const std::optional<QList<QUuid>>& idInclusionFilter = std::nullopt); // Ordered by platform
+    QFuture<AsyncResult<QList<Entry>>> queryEntrysAsync(const EntryFilter& filter);
+    QFuture<AsyncResult<QList<QUuid>>> searchEntrysAsync(const QString& text, int limit = -1);
+    QFuture<AsyncResult<Entry>> getEntryAsync(const QUuid& entryId);
+    QFuture<AsyncResult<QHash<QUuid, Entry>>> getEntriesAsync(const QList<QUuid>& entryIds);
+    QFuture<AsyncResult<GameData>> getGameDataAsync(const QUuid& gameId);
+    QFuture<AsyncResult<GameTags>> getGameTagsAsync(const QUuid& gameId);
+
+//-Signals & Slots------------------------------------------------------------------------------------------------------------
+private slots:
+    void fileChangeHandler(const QString& path);
+
+signals:
+    void metadataChanged();
 };
 
 }
@@ -0,0 +1,81 @@
+#ifndef FLASHPOINT_DBVIEW_H
+#define FLASHPOINT_DBVIEW_H
+
+// Shared Lib Support
+#include "fp/fp_export.h"
+
+// Qt Includes
+#include <QUtf8StringView>
+
+// Project Includes
+#include "fp/fp-db.h"
+#include "fp/fp-items.h"
+
+/* Row views only exist when libfp is built with LIBFP_NATIVE_SQLITE, which defines FP_NATIVE_SQLITE for users of the
+ * library as well. Without it this header is empty, so that code relying on views fails to build instead of reading
+ * nothing at runtime.
+ */
+#ifdef FP_NATIVE_SQLITE
+namespace Fp
+{
+
+/* Views onto the current row of a native result. Nothing is copied, so all returned data is only valid until the
+ * visitor that received the view returns.
+ */
+class FP_FP_EXPORT RowView
+{
+//-Instance Variables-----------------------------------------------------------------------------------------------
+protected:
+    const void* mRow;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+protected:
+    explicit RowView(const void* row);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    bool isNull(int column) const;
+    QUtf8StringView text(int column) const;
+    qint64 integer(int column) const;
+};
+
+class FP_FP_EXPORT GameView : public RowView
+{
+    friend class Db;
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    explicit GameView(const void* row);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    Game toGame() const; // Columns are Db::Table_Game::Ordinal
+};
+
+class FP_FP_EXPORT AddAppView : public RowView
+{
+    friend class Db;
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    explicit AddAppView(const void* row);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    AddApp toAddApp() const; // Columns are Db::Table_Add_App::Ordinal
+};
+
+class FP_FP_EXPORT GameDataView : public RowView
+{
+    friend class Db;
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    explicit GameDataView(const void* row);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    GameData toGameData() const; // Columns are Db::Table_Game_Data::Ordinal
+};
+
+}
+#endif
+
+#endif // FLASHPOINT_DBVIEW_H
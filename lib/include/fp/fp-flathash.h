@@ -0,0 +1,218 @@
+#ifndef FLASHPOINT_FLATHASH_H
+#define FLASHPOINT_FLATHASH_H
+
+// Standard Library Includes
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+// Qt Includes
+#include <QList>
+#include <QUuid>
+
+namespace Fp
+{
+
+//-Hashing---------------------------------------------------------------------------------------------------
+namespace FlatHashing
+{
+    inline quint64 mix(quint64 x)
+    {
+        // MurmurHash3 finalizer, spreads every input bit over the whole word
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    inline quint64 hash(int key) { return mix(static_cast<quint32>(key)); }
+
+    inline quint64 hash(const QUuid& key)
+    {
+        // Most IDs are random already, but not all of them are version 4
+        static_assert(sizeof(QUuid) == 2 * sizeof(quint64) && std::is_trivially_copyable_v<QUuid>);
+        quint64 halves[2];
+        std::memcpy(halves, &key, sizeof(QUuid));
+        return mix(halves[0] ^ std::rotl(halves[1], 31));
+    }
+}
+
+/* Hash table that keeps keys and values inline in one array and resolves collisions by linear probing, intended for
+ * lookup tables that are built once and then read a lot. A parallel array of control bytes marks each slot as empty or
+ * holds 7 bits of its key's hash, so probing mostly scans a few adjacent bytes and only compares keys on a likely match.
+ *
+ * The interface follows QHash for what it covers. There is no removal, which keeps probe sequences unbroken.
+ */
+template<typename Key, typename T>
+class FlatHash
+{
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static constexpr quint8 EMPTY = 0;
+    static constexpr quint8 USED = 0x80; // Low bits are from the hash
+    static constexpr qsizetype MIN_CAPACITY = 16;
+
+//-Structs-----------------------------------------------------------------------------------------------------
+private:
+    struct Slot
+    {
+        Key key;
+        T value;
+    };
+
+//-Inner Classes-------------------------------------------------------------------------------------------------
+public:
+    class const_iterator
+    {
+        friend class FlatHash;
+    //-Instance Variables-----------------------------------------------------------------------------------------------
+    private:
+        const FlatHash* mHash;
+        qsizetype mIndex;
+
+    //-Constructor-------------------------------------------------------------------------------------------------
+    private:
+        const_iterator(const FlatHash* hash, qsizetype index) : mHash(hash), mIndex(index) { skipEmpty(); }
+
+    //-Instance Functions------------------------------------------------------------------------------------------------------
+    private:
+        void skipEmpty()
+        {
+            while(mIndex < mHash->mControl.size() && mHash->mControl.at(mIndex) == EMPTY)
+                mIndex++;
+        }
+
+    public:
+        const Key& key() const { return mHash->mSlots.at(mIndex).key; }
+        const T& value() const { return mHash->mSlots.at(mIndex).value; }
+
+    //-Operators-----------------------------------------------------------------------------------------------------
+    public:
+        const T& operator*() const { return value(); }
+        const T* operator->() const { return &value(); }
+        const_iterator& operator++() { mIndex++; skipEmpty(); return *this; }
+        bool operator==(const const_iterator& other) const = default;
+    };
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QList<quint8> mControl;
+    QList<Slot> mSlots;
+    qsizetype mSize;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    FlatHash() : mSize(0) {}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+private:
+    static quint8 control(quint64 hash) { return USED | static_cast<quint8>(hash >> 57); }
+
+    static qsizetype capacityFor(qsizetype count)
+    {
+        // Keep the load at or under 7/8
+        return std::bit_ceil(static_cast<quint64>(std::max(MIN_CAPACITY, count + count / 7 + 1)));
+    }
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    qsizetype mask() const { return mControl.size() - 1; }
+
+    qsizetype findIndex(const Key& key) const
+    {
+        if(mControl.isEmpty())
+            return -1;
+
+        quint64 h = FlatHashing::hash(key);
+        quint8 c = control(h);
+        for(qsizetype i = h & mask(); ; i = (i + 1) & mask())
+        {
+            quint8 found = mControl.at(i);
+            if(found == EMPTY)
+                return -1;
+            if(found == c && mSlots.at(i).key == key)
+                return i;
+        }
+    }
+
+    void rehash(qsizetype capacity)
+    {
+        QList<quint8> oldControl = std::exchange(mControl, QList<quint8>(capacity, EMPTY));
+        QList<Slot> oldSlots = std::exchange(mSlots, QList<Slot>(capacity));
+
+        for(qsizetype i = 0; i < oldControl.size(); i++)
+            if(oldControl.at(i) != EMPTY)
+                place(std::move(oldSlots[i]));
+    }
+
+    void place(Slot&& slot)
+    {
+        // Key is known to be absent
+        quint64 h = FlatHashing::hash(slot.key);
+        qsizetype i = h & mask();
+        while(mControl.at(i) != EMPTY)
+            i = (i + 1) & mask();
+
+        mControl[i] = control(h);
+        mSlots[i] = std::move(slot);
+    }
+
+public:
+    qsizetype size() const { return mSize; }
+    bool isEmpty() const { return mSize == 0; }
+    qsizetype capacity() const { return mControl.size(); }
+
+    void reserve(qsizetype count)
+    {
+        if(qsizetype needed = capacityFor(count); needed > mControl.size())
+            rehash(needed);
+    }
+
+    void clear()
+    {
+        mControl.clear();
+        mSlots.clear();
+        mSize = 0;
+    }
+
+    void insert(const Key& key, const T& value)
+    {
+        if(qsizetype i = findIndex(key); i >= 0)
+        {
+            mSlots[i].value = value;
+            return;
+        }
+
+        reserve(mSize + 1);
+        place({key, value});
+        mSize++;
+    }
+
+    bool contains(const Key& key) const { return findIndex(key) >= 0; }
+
+    T value(const Key& key, const T& defaultValue = T()) const
+    {
+        qsizetype i = findIndex(key);
+        return i >= 0 ? mSlots.at(i).value : defaultValue;
+    }
+
+    const_iterator constFind(const Key& key) const
+    {
+        qsizetype i = findIndex(key);
+        return i >= 0 ? const_iterator(this, i) : constEnd();
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, mControl.size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    const_iterator constBegin() const { return begin(); }
+    const_iterator constEnd() const { return end(); }
+};
+
+}
+
+#endif // FLASHPOINT_FLATHASH_H
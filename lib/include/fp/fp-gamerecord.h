@@ -0,0 +1,115 @@
+#ifndef FLASHPOINT_GAMERECORD_H
+#define FLASHPOINT_GAMERECORD_H
+
+// Shared Lib Support
+#include "fp/fp_export.h"
+
+// Standard Library Includes
+#include <limits>
+#include <span>
+
+// Qt Includes
+#include <QList>
+#include <QHash>
+
+// Project Includes
+#include "fp/fp-items.h"
+#include "fp/fp-snapshot.h"
+#include "fp/fp-flathash.h"
+
+namespace Fp
+{
+
+/* Packed form of a Game, for holding many games at once. Text fields are ids into the string table of the
+ * GameRecordSet the record belongs to, and the rarely needed long text (notes and the original description) is kept
+ * apart from the records so that walking them stays dense.
+ */
+struct GameRecord
+{
+    using StringId = Snapshot::StringId;
+
+    QUuid id;
+    qint64 dateAdded; // Milliseconds since epoch, UTC
+    qint64 dateModified; // Milliseconds since epoch, UTC
+    qint64 releaseDate; // Milliseconds since epoch, local time as with Game
+    StringId title;
+    StringId series;
+    StringId developer;
+    StringId publisher;
+    StringId playMode;
+    StringId statusText;
+    StringId source;
+    StringId appPath;
+    StringId launchCommand;
+    StringId version;
+    StringId language;
+    StringId orderTitle;
+    StringId libraryText;
+    StringId platformName;
+    StringId ruffleSupport;
+    quint32 longText; // GameRecordSet::NO_TEXT if the game has none or it wasn't loaded
+    quint8 statusFlags; // Snapshot::Status, which on its own takes an int
+    Snapshot::Library library;
+    bool broken;
+
+    Snapshot::Status status() const { return Snapshot::Status::fromInt(statusFlags); }
+};
+
+/* An immutable collection of GameRecords that owns their strings, so like Snapshot it can be read from any number of
+ * threads at once without locking.
+ */
+class FP_FP_EXPORT GameRecordSet
+{
+    friend class Db;
+//-Structs-----------------------------------------------------------------------------------------------------
+private:
+    struct LongText
+    {
+        QString notes;
+        QString originalDescription;
+    };
+
+//-Class Variables-----------------------------------------------------------------------------------------------
+public:
+    static constexpr quint32 NO_TEXT = std::numeric_limits<quint32>::max();
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QList<GameRecord> mRecords;
+    QStringList mStrings; // Id 0 is always the empty string
+    QList<LongText> mLongText;
+    bool mHasLongText;
+    FlatHash<QUuid, quint32> mIndex;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    explicit GameRecordSet(bool hasLongText);
+
+//-Class Functions--------------------------------------------------------------------------------------------
+private:
+    static QDateTime fromEpoch(qint64 epoch, Qt::TimeSpec spec);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    // Building
+    void append(const Game& game, QHash<QString, GameRecord::StringId>& interned);
+    void seal();
+
+public:
+    bool isEmpty() const;
+    qsizetype size() const;
+    bool hasLongText() const;
+
+    std::span<const GameRecord> records() const;
+    const GameRecord& at(qsizetype i) const;
+    const GameRecord* find(const QUuid& id) const; // IDs are not redirected
+    const QString& string(GameRecord::StringId id) const;
+    QString notes(const GameRecord& record) const;
+    QString originalDescription(const GameRecord& record) const;
+
+    Game toGame(const GameRecord& record) const;
+};
+
+}
+
+#endif // FLASHPOINT_GAMERECORD_H
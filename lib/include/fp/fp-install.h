@@ -155,7 +155,7 @@ private:
 
 //-Constructor-------------------------------------------------------------------------------------------------
 public:
-    Install(QString installPath, bool preloadPlaylists = false);
+    Install(QString installPath, bool preloadPlaylists = false, const Db::ConnectionProfile& dbProfile = {});
 
 //-Destructor-------------------------------------------------------------------------------------------------
 public:
@@ -18,6 +18,34 @@ namespace Fp
 enum class ImageType {Logo, Screenshot};
 
 //-Namespace Classes---------------------------------------------------------------------------------------------
+/* Identity of a pooled string value. The fields Game pools are kept once per process for each distinct value, so equal
+ * values always share one buffer and their atoms compare and hash by its address alone. An atom doesn't hold the
+ * value, use the matching QString getter for that.
+ */
+class FP_FP_EXPORT Atom
+{
+    friend class Game;
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    const void* mData; // Pooled buffer, null for the empty string
+
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    explicit Atom(const QString& pooled);
+
+public:
+    Atom();
+
+//-Instance Functions------------------------------------------------------------------------------------------
+public:
+    bool isEmpty() const;
+
+//-Friend Functions------------------------------------------------------------------------------------------------
+public:
+    friend bool operator==(const Atom& lhs, const Atom& rhs) noexcept = default;
+    friend size_t qHash(const Atom& key, size_t seed) noexcept { return qHash(key.mData, seed); }
+};
+
 class FP_FP_EXPORT Game
 {
 //-Inner Classes----------------------------------------------------------------------------------------------------
@@ -77,6 +105,16 @@ public:
     QString library() const;
     QString platformName() const;
     QString ruffleSupport() const;
+
+    // Pooled fields
+    Atom developerAtom() const;
+    Atom publisherAtom() const;
+    Atom playModeAtom() const;
+    Atom statusAtom() const;
+    Atom languageAtom() const;
+    Atom libraryAtom() const;
+    Atom platformNameAtom() const;
+    Atom ruffleSupportAtom() const;
 };
 
 class FP_FP_EXPORT Game::Builder
@@ -92,17 +130,22 @@ public:
 //-Class Functions---------------------------------------------------------------------------------------------
 private:
     static QString kosherizeRawDate(const QString& date);
+    static QString pooled(const QString& str);
 
 //-Instance Functions------------------------------------------------------------------------------------------
 public:
     Builder& wId(QStringView rawId);
+    Builder& wId(const QUuid& id);
     Builder& wTitle(const QString& title);
     Builder& wSeries(const QString& series);
     Builder& wDeveloper(const QString& developer);
     Builder& wPublisher(const QString& publisher);
     Builder& wDateAdded(QStringView rawDateAdded);
+    Builder& wDateAdded(const QDateTime& dateAdded);
     Builder& wDateModified(QStringView rawDateModified);
+    Builder& wDateModified(const QDateTime& dateModified);
     Builder& wBroken(QStringView rawBroken);
+    Builder& wBroken(bool broken);
     Builder& wPlayMode(const QString& playMode);
     Builder& wStatus(const QString& status);
     Builder& wNotes(const QString& notes);
@@ -110,6 +153,7 @@ public:
     Builder& wAppPath(const QString& appPath);
     Builder& wLaunchCommand(const QString& launchCommand);
     Builder& wReleaseDate(QStringView rawReleaseDate);
+    Builder& wReleaseDate(const QDateTime& releaseDate);
     Builder& wVersion(const QString& version);
     Builder& wOriginalDescription(const QString& originalDescription);
     Builder& wLanguage(const QString& language);
@@ -204,14 +248,19 @@ public:
 //-Instance Functions------------------------------------------------------------------------------------------
 public:
     Builder& wId(QStringView rawId);
+    Builder& wId(quint32 id);
     Builder& wGameId(QStringView rawId);
     Builder& wTitle(const QString& title);
     Builder& wDateAdded(const QString& rawDateAdded);
+    Builder& wDateAdded(const QDateTime& dateAdded);
     Builder& wSha256(const QString& sha256);
     Builder& wCrc32(QStringView rawCrc32);
+    Builder& wCrc32(quint32 crc32);
     Builder& wPresentOnDisk(QStringView rawBroken);
+    Builder& wPresentOnDisk(bool presentOnDisk);
     Builder& wPath(const QString& path);
     Builder& wSize(QStringView rawSize);
+    Builder& wSize(quint32 size);
     Builder& wRawParameters(const QString& parameters);
     Builder& wAppPath(const QString& appPath);
     Builder& wLaunchCommand(const QString& launchCommand);
@@ -316,9 +365,11 @@ public:
     Builder& wId(QStringView rawId);
     Builder& wAppPath(const QString& appPath);
     Builder& wAutorunBefore(QStringView rawAutorunBefore);
+    Builder& wAutorunBefore(bool autorunBefore);
     Builder& wLaunchCommand(const QString& launchCommand);
     Builder& wName(const QString& name);
     Builder& wWaitExit(QStringView rawWaitExit);
+    Builder& wWaitExit(bool waitExit);
     Builder& wParentId(QStringView rawParentId);
 
     AddApp build();
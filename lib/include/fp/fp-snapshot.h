@@ -0,0 +1,174 @@
+#ifndef FLASHPOINT_SNAPSHOT_H
+#define FLASHPOINT_SNAPSHOT_H
+
+// Shared Lib Support
+#include "fp/fp_export.h"
+
+// Standard Library Includes
+#include <limits>
+#include <span>
+
+// Qt Includes
+#include <QtSql>
+
+// Project Includes
+#include "fp/fp-items.h"
+#include "fp/fp-flathash.h"
+
+namespace Fp
+{
+
+/* Column oriented copy of the game, add app and game data tables. A snapshot never changes once loaded, so a single
+ * instance can be read from any number of threads at once without locking.
+ *
+ * Each table is stored as one list per column, all of equal length, and a row is simply an index into them. Text is
+ * interned into a single pool, so columns hold pool ids and repeated values (platforms, developers, etc.) are stored
+ * once.
+ */
+class FP_FP_EXPORT Snapshot
+{
+    friend class Db;
+//-Class Enums---------------------------------------------------------------------------------------------------
+public:
+    enum class Library : quint8 { Arcade, Theatre, Other };
+
+    enum StatusFlag : quint8
+    {
+        NoStatus = 0x00,
+        Playable = 0x01,
+        Partial = 0x02,
+        Hacked = 0x04,
+        NotWorking = 0x08,
+        OtherStatus = 0x10
+    };
+    Q_DECLARE_FLAGS(Status, StatusFlag);
+
+//-Aliases-------------------------------------------------------------------------------------------------------
+public:
+    using StringId = quint32;
+
+//-Structs-----------------------------------------------------------------------------------------------------
+public:
+    struct GameColumns
+    {
+        QList<QUuid> id;
+        QList<QUuid> parentId;
+        QList<StringId> title;
+        QList<StringId> series;
+        QList<StringId> developer;
+        QList<StringId> publisher;
+        QList<qint64> dateAdded; // Milliseconds since epoch, UTC
+        QList<qint64> dateModified; // Milliseconds since epoch, UTC
+        QList<bool> broken;
+        QList<StringId> playMode;
+        QList<Status> status;
+        QList<StringId> statusText;
+        QList<StringId> notes;
+        QList<StringId> source;
+        QList<StringId> appPath;
+        QList<StringId> launchCommand;
+        QList<StringId> releaseDate; // Kept as text since many are only partial dates
+        QList<StringId> version;
+        QList<StringId> originalDescription;
+        QList<StringId> language;
+        QList<StringId> orderTitle;
+        QList<Library> library;
+        QList<StringId> libraryText;
+        QList<StringId> platformName;
+        QList<StringId> ruffleSupport;
+    };
+
+    struct AddAppColumns
+    {
+        QList<QUuid> id;
+        QList<QUuid> parentId;
+        QList<quint32> parentRow; // NO_ROW for orphans
+        QList<StringId> appPath;
+        QList<bool> autorunBefore;
+        QList<StringId> launchCommand;
+        QList<StringId> name;
+        QList<bool> waitExit;
+    };
+
+    struct GameDataColumns
+    {
+        QList<quint32> id;
+        QList<QUuid> gameId;
+        QList<quint32> gameRow; // NO_ROW for orphans
+        QList<StringId> title;
+        QList<qint64> dateAdded; // Milliseconds since epoch, UTC
+        QList<StringId> sha256;
+        QList<quint32> crc32;
+        QList<bool> presentOnDisk;
+        QList<StringId> path;
+        QList<quint32> size;
+        QList<StringId> parameters;
+        QList<StringId> appPath;
+        QList<StringId> launchCommand;
+    };
+
+//-Class Variables-----------------------------------------------------------------------------------------------
+public:
+    static constexpr quint32 NO_ROW = std::numeric_limits<quint32>::max();
+    static constexpr qint64 NO_DATE = std::numeric_limits<qint64>::min();
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QStringList mStrings; // Id 0 is always the empty string
+    GameColumns mGames;
+    AddAppColumns mAddApps;
+    GameDataColumns mGameData;
+
+    // Lookup
+    FlatHash<QUuid, quint32> mGameIndex;
+    FlatHash<QUuid, quint32> mAddAppIndex;
+
+    // Children grouped by parent game row, the rows of game N are [offsets[N], offsets[N + 1])
+    QList<quint32> mAddAppOffsets;
+    QList<quint32> mAddAppsByGame;
+    QList<quint32> mGameDataOffsets;
+    QList<quint32> mGameDataByGame;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    Snapshot();
+
+//-Class Functions--------------------------------------------------------------------------------------------
+private:
+    static QDateTime fromEpoch(qint64 epoch);
+    static void groupByGame(QList<quint32>& offsets, QList<quint32>& rows, const QList<quint32>& gameRows, quint32 gameCount);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    QSqlError load(QSqlDatabase& database);
+    QSqlError loadGames(QSqlDatabase& database, QHash<QString, StringId>& interned);
+    QSqlError loadAddApps(QSqlDatabase& database, QHash<QString, StringId>& interned);
+    QSqlError loadGameData(QSqlDatabase& database, QHash<QString, StringId>& interned);
+
+public:
+    // Tables
+    quint32 gameCount() const;
+    quint32 addAppCount() const;
+    quint32 gameDataCount() const;
+    const GameColumns& games() const;
+    const AddAppColumns& addApps() const;
+    const GameDataColumns& gameData() const;
+    const QString& string(StringId id) const;
+
+    // Lookup (IDs are not redirected)
+    quint32 findGame(const QUuid& id) const;
+    quint32 findAddApp(const QUuid& id) const;
+    std::span<const quint32> addAppRows(quint32 gameRow) const;
+    std::span<const quint32> gameDataRows(quint32 gameRow) const;
+
+    // Items
+    Game game(quint32 row) const;
+    AddApp addApp(quint32 row) const;
+    GameData gameData(quint32 row) const;
+};
+
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Fp::Snapshot::Status);
+
+#endif // FLASHPOINT_SNAPSHOT_H
@@ -0,0 +1,97 @@
+#ifndef FLASHPOINT_TAGDIRECTORY_H
+#define FLASHPOINT_TAGDIRECTORY_H
+
+// Shared Lib Support
+#include "fp/fp_export.h"
+
+// Standard Library Includes
+#include <limits>
+#include <mutex>
+#include <span>
+
+// Qt Includes
+#include <QList>
+#include <QColor>
+
+// Project Includes
+#include "fp/fp-db.h"
+#include "fp/fp-flathash.h"
+
+namespace Fp
+{
+
+/* Every tag and tag category of a database, stored contiguously. Tags are grouped by category so that the tags of a
+ * category are one span, categories are ordered by ID and tags are ordered by ID within their category. Each category
+ * name is stored once and shared by its tags.
+ *
+ * A directory is never modified once built, so it can be shared between threads and its spans, pointers and handles
+ * stay valid for as long as it's held.
+ */
+class FP_FP_EXPORT TagDirectory
+{
+    friend class Db;
+    friend class MetadataCache;
+//-Aliases-------------------------------------------------------------------------------------------------------
+public:
+    using Handle = quint32; // Position of a tag within tags()
+
+//-Structs-----------------------------------------------------------------------------------------------------
+public:
+    struct Category
+    {
+        int id;
+        QString name;
+        QColor color;
+        Handle firstTag;
+        quint32 tagCount;
+    };
+
+//-Class Variables-----------------------------------------------------------------------------------------------
+public:
+    static constexpr Handle NO_TAG = std::numeric_limits<Handle>::max();
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QList<Db::Tag> mTags;
+    QList<Category> mCategories;
+    FlatHash<int, Handle> mTagHandles; // Tag ID -> Handle
+    FlatHash<int, quint32> mCategoryIndices; // Category ID -> Position within categories()
+
+    // Only used while building, category position of each tag
+    QList<quint32> mPendingCategories;
+
+    // Nested layout, built on first request
+    mutable std::once_flag mMapBuilt;
+    mutable QMap<int, Db::TagCategory> mMap;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    TagDirectory();
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    // Building
+    void addCategory(int id, const QString& name, const QColor& color);
+    bool addTag(int id, const QString& primaryAlias, int categoryId);
+    void seal();
+
+public:
+    bool isEmpty() const;
+    qsizetype tagCount() const;
+    qsizetype categoryCount() const;
+
+    std::span<const Db::Tag> tags() const;
+    std::span<const Db::Tag> tags(const Category& category) const;
+    std::span<const Category> categories() const;
+
+    Handle handle(int tagId) const;
+    const Db::Tag& tagAt(Handle handle) const;
+    const Db::Tag* findTag(int tagId) const;
+    const Category* findCategory(int categoryId) const;
+
+    QMap<int, Db::TagCategory> toMap() const; // Shares one copy between all callers
+};
+
+}
+
+#endif // FLASHPOINT_TAGDIRECTORY_H
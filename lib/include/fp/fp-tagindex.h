@@ -0,0 +1,165 @@
+#ifndef FLASHPOINT_TAGINDEX_H
+#define FLASHPOINT_TAGINDEX_H
+
+// Shared Lib Support
+#include "fp/fp_export.h"
+
+// Qt Includes
+#include <QList>
+#include <QHash>
+#include <QUuid>
+
+// Project Includes
+#include "fp/fp-db.h"
+#include "fp/fp-flathash.h"
+
+namespace Fp
+{
+
+/* Compressed set of game ordinals, laid out like a roaring bitmap: values are split by their upper 16 bits into
+ * containers that store the lower 16 bits either as a sorted array while sparse, or as a plain 65536 bit bitmap once
+ * dense.
+ */
+class FP_FP_EXPORT GameSet
+{
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static constexpr int ARRAY_LIMIT = 4096; // Beyond this a bitmap is smaller than an array
+    static constexpr int BITMAP_WORDS = 1024;
+
+//-Structs-----------------------------------------------------------------------------------------------------
+private:
+    struct Container
+    {
+        quint16 key;
+        int cardinality;
+        QList<quint16> array; // Empty once converted to a bitmap
+        QList<quint64> bitmap;
+
+        bool isBitmap() const;
+        bool contains(quint16 low) const;
+        void toBitmap();
+        void normalize();
+    };
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QList<Container> mContainers; // Sorted by key
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    GameSet();
+
+//-Class Functions--------------------------------------------------------------------------------------------
+private:
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static Container subtract(const Container& a, const Container& b);
+
+public:
+    static GameSet fromSorted(const QList<quint32>& ordinals);
+    static GameSet range(quint32 count);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    bool isEmpty() const;
+    qsizetype cardinality() const;
+    bool contains(quint32 ordinal) const;
+    QList<quint32> toList() const;
+
+    GameSet intersected(const GameSet& other) const;
+    GameSet united(const GameSet& other) const;
+    GameSet subtracted(const GameSet& other) const;
+
+//-Operators-----------------------------------------------------------------------------------------------------
+public:
+    GameSet operator&(const GameSet& other) const;
+    GameSet operator|(const GameSet& other) const;
+    GameSet operator-(const GameSet& other) const;
+};
+
+/* Inverted index from tags, and tag categories, to the games that carry them. Built once per Db and never modified
+ * afterwards, so it can be shared between threads.
+ *
+ * Expressions combine tag names (primary aliases, case-insensitive) with the uppercase operators AND, OR, NOT and
+ * parentheses, i.e. "Puzzle AND NOT (Extreme OR Multiplayer)". Names containing operators or parentheses can be
+ * quoted, and a category is matched with the "category:" prefix, i.e. category:"Content Tags".
+ */
+class FP_FP_EXPORT TagIndex
+{
+    friend class Db;
+    friend class TestAccess;
+//-Class Enums---------------------------------------------------------------------------------------------------
+private:
+    enum class TokenType { Word, Quoted, And, Or, Not, Open, Close, End };
+
+//-Structs-----------------------------------------------------------------------------------------------------
+private:
+    struct Token
+    {
+        TokenType type;
+        QString text;
+        qsizetype position;
+    };
+
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static inline const QString CATEGORY_PREFIX = u"category:"_s;
+
+    // Error
+    static inline const QString ERR_UNKNOWN_TAG = u"The expression references an unknown tag: %1"_s;
+    static inline const QString ERR_UNKNOWN_CATEGORY = u"The expression references an unknown tag category: %1"_s;
+    static inline const QString ERR_UNEXPECTED = u"Unexpected token '%1' in tag expression at position %2."_s;
+    static inline const QString ERR_UNTERMINATED = u"Tag expression contains an unterminated quote at position %1."_s;
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QList<QUuid> mGames; // Ordinal -> Game ID
+    FlatHash<QUuid, quint32> mOrdinals;
+    QHash<int, GameSet> mTagSets;
+    QHash<QString, GameSet> mCategorySets; // Lowercase name
+    QHash<QString, int> mTagNames; // Lowercase primary alias -> Tag ID
+
+    // Only used while building
+    QHash<int, QList<quint32>> mPendingTags;
+    QHash<QString, QList<quint32>> mPendingCategories;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    TagIndex();
+
+//-Class Functions--------------------------------------------------------------------------------------------
+private:
+    static DbError tokenize(QList<Token>& tokens, const QString& expression);
+    static DbError unexpected(const Token& token);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    // Building
+    void addGame(const QUuid& gameId);
+    void addTag(const Db::Tag& tag);
+    void addMembership(const QUuid& gameId, const Db::Tag& tag);
+    void seal();
+
+    // Parsing
+    DbError parseOr(GameSet& result, const QList<Token>& tokens, qsizetype& pos) const;
+    DbError parseAnd(GameSet& result, const QList<Token>& tokens, qsizetype& pos) const;
+    DbError parseNot(GameSet& result, const QList<Token>& tokens, qsizetype& pos) const;
+    DbError parseTerm(GameSet& result, const QList<Token>& tokens, qsizetype& pos) const;
+
+public:
+    quint32 gameCount() const;
+    QUuid gameId(quint32 ordinal) const;
+    QList<QUuid> gameIds(const GameSet& set) const;
+    std::optional<quint32> ordinal(const QUuid& gameId) const;
+
+    GameSet allGames() const;
+    GameSet tag(int tagId) const;
+    GameSet category(const QString& name) const;
+
+    DbError evaluate(GameSet& result, const QString& expression) const;
+};
+
+}
+
+#endif // FLASHPOINT_TAGINDEX_H
@@ -0,0 +1,47 @@
+// Unit Includes
+#include "fp-changetracker.h"
+
+namespace Fp
+{
+
+//===============================================================================================================
+// ChangeTracker
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+ChangeTracker::ChangeTracker(const QString& sourcePath, const std::optional<MetadataCache::Stamp>& baseline) :
+    mSourcePath(sourcePath),
+    mGeneration(BASELINE_GENERATION),
+    mStamp(baseline)
+{}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+QSqlError ChangeTracker::check(quint64& resultBuffer, PooledConnection& connection)
+{
+    // Version before stamp, so that a commit landing in between is counted twice rather than not at all
+    QSqlQuery versionQuery(u"PRAGMA data_version"_s, connection.database);
+    if(!versionQuery.next())
+        return versionQuery.lastError();
+    qint64 version = versionQuery.value(0).toLongLong();
+
+    bool known = connection.dataVersion.has_value();
+    bool moved = known && *connection.dataVersion != version;
+    connection.dataVersion = version;
+
+    if(!known || moved)
+    {
+        std::optional<MetadataCache::Stamp> stamp = MetadataCache::stampOf(mSourcePath);
+
+        QMutexLocker stampLocker(&mStampMutex);
+        if(moved || !stamp || !mStamp || *stamp != *mStamp)
+            mGeneration++;
+        mStamp = stamp;
+    }
+
+    resultBuffer = mGeneration;
+    return QSqlError();
+}
+
+}
@@ -0,0 +1,48 @@
+#ifndef FLASHPOINT_CHANGETRACKER_H
+#define FLASHPOINT_CHANGETRACKER_H
+
+// Standard Library Includes
+#include <atomic>
+#include <optional>
+
+// Qt Includes
+#include <QtSql>
+
+// Project Includes
+#include "fp-connectionpool.h"
+#include "fp-metadatacache.h"
+
+namespace Fp
+{
+
+/* Notices commits made through any connection other than the one asking, in this process or another. PRAGMA
+ * data_version only moves for such commits since the same connection last asked, so each connection keeps its own
+ * baseline and any movement bumps one shared generation. A connection asking for the first time has no baseline, so
+ * instead the file is compared with how it looked when the generation last moved.
+ */
+class ChangeTracker
+{
+//-Class Variables-----------------------------------------------------------------------------------------------
+public:
+    // Generation of the file as given by the baseline stamp, until a check finds otherwise
+    static constexpr quint64 BASELINE_GENERATION = 0;
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    const QString mSourcePath;
+    std::atomic<quint64> mGeneration;
+    QMutex mStampMutex;
+    std::optional<MetadataCache::Stamp> mStamp; // File as of the current generation
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    ChangeTracker(const QString& sourcePath, const std::optional<MetadataCache::Stamp>& baseline);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    QSqlError check(quint64& resultBuffer, PooledConnection& connection); // Connection must be owned by the calling thread
+};
+
+}
+
+#endif // FLASHPOINT_CHANGETRACKER_H
@@ -0,0 +1,324 @@
+// Unit Includes
+#include "fp-connectionpool.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <vector>
+
+namespace Fp
+{
+
+//===============================================================================================================
+// ThreadConnections
+//===============================================================================================================
+
+/* The connections a thread opened, across all pools. Their owning thread closes them here at the latest when it exits,
+ * unless another thread evicted them first.
+ */
+class ThreadConnections
+{
+//-Structs-----------------------------------------------------------------------------------------------------
+public:
+    struct Entry
+    {
+        std::weak_ptr<ConnectionPool> pool;
+        const ConnectionPool* poolAddress;
+        std::shared_ptr<PooledConnection> connection; // Leases hold on to it as well, so it outlives a late lease
+        std::weak_ptr<PooledConnection> lease;
+    };
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    std::vector<Entry> mEntries;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    ThreadConnections() = default;
+
+//-Destructor-------------------------------------------------------------------------------------------------
+public:
+    ~ThreadConnections()
+    {
+        // Leases can't be in use by the thread that is ending, and using them from another one isn't allowed anyway
+        for(Entry& entry : mEntries)
+            close(entry);
+    }
+
+//-Class Functions--------------------------------------------------------------------------------------------
+public:
+    static ThreadConnections& local()
+    {
+        thread_local ThreadConnections connections;
+        return connections;
+    }
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+private:
+    void close(Entry& entry)
+    {
+        // An evicted connection is closed by whoever evicted it
+        if(std::shared_ptr<ConnectionPool> pool = entry.pool.lock(); pool && !pool->forget(entry.connection.get()))
+            return;
+        ConnectionPool::destroy(entry.connection.get());
+    }
+
+public:
+    Entry* find(const ConnectionPool* pool)
+    {
+        // Address alone could belong to a later pool, so also check that the original is still around
+        auto itr = std::find_if(mEntries.begin(), mEntries.end(), [pool](const Entry& e){
+            return e.poolAddress == pool && !e.pool.expired();
+        });
+        return itr != mEntries.end() ? &(*itr) : nullptr;
+    }
+
+    Entry& add(const std::weak_ptr<ConnectionPool>& pool, const std::shared_ptr<PooledConnection>& connection)
+    {
+        return mEntries.emplace_back(Entry{.pool = pool, .poolAddress = pool.lock().get(), .connection = connection, .lease = {}});
+    }
+
+    void close(const ConnectionPool* pool)
+    {
+        // Only the entry of the given pool, and only if it's idle
+        auto itr = std::find_if(mEntries.begin(), mEntries.end(), [pool](const Entry& e){ return e.poolAddress == pool; });
+        if(itr != mEntries.end() && itr->lease.expired())
+        {
+            close(*itr);
+            mEntries.erase(itr);
+        }
+    }
+
+    void sweep(const ConnectionPool* except)
+    {
+        // Close idle connections of pools that are gone or that are past their idle timeout, and drop evicted ones
+        std::erase_if(mEntries, [this, except](Entry& e){
+            if(e.poolAddress == except || !e.lease.expired())
+                return false;
+
+            std::shared_ptr<ConnectionPool> pool = e.pool.lock();
+            if(pool && !pool->closeDue(e.connection.get()))
+                return false;
+
+            close(e);
+            return true;
+        });
+    }
+};
+
+//===============================================================================================================
+// ConnectionPool
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+ConnectionPool::ConnectionPool(const QString& namePrefix, const Opener& opener, int maxSize, std::chrono::milliseconds idleTimeout) :
+    mNamePrefix(namePrefix),
+    mOpener(opener),
+    mMaxSize(std::max(maxSize, 1)),
+    mIdleTimeout(idleTimeout),
+    mNameCounter(0),
+    mOpening(0),
+    mWaiting(0)
+{}
+
+//-Destructor------------------------------------------------------------------------------------------------
+//Public:
+ConnectionPool::~ConnectionPool()
+{
+    // Close everything that's idle now, connections still leased are closed by their thread once done
+    for(const std::shared_ptr<PooledConnection>& connection : evictAllIdle())
+        destroy(connection.get());
+    ThreadConnections::local().sweep(nullptr);
+}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Private:
+void ConnectionPool::destroy(PooledConnection* connection)
+{
+    // The owner and an evicting thread can both get here once the pool is gone, only the first one closes
+    if(connection->closed.exchange(true))
+        return;
+
+    /* All statements and handles must be gone before the connection is removed or else Qt will post a warning
+     * since any instances that remain would have a stale reference to the database.
+     */
+    QString name = connection->database.connectionName();
+    connection->statements.clear();
+    connection->statementOrder.clear();
+    connection->database.close();
+    connection->database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(name);
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Private:
+std::shared_ptr<PooledConnection> ConnectionPool::lease(const std::shared_ptr<PooledConnection>& connection)
+{
+    // NOTE: Caller must have marked the connection as leased. The lease returns it once every holder is done with it
+    std::weak_ptr<ConnectionPool> weakPool = weak_from_this();
+    return std::shared_ptr<PooledConnection>(connection.get(), [weakPool, connection](PooledConnection* c){
+        if(std::shared_ptr<ConnectionPool> pool = weakPool.lock())
+            pool->release(c);
+    });
+}
+
+void ConnectionPool::release(PooledConnection* connection)
+{
+    // The last holder may not be the owner, which doesn't matter since a waiting thread can now evict it
+    QMutexLocker poolLocker(&mMutex);
+    connection->leased = false;
+    connection->idleTimer.start();
+    if(mWaiting > 0)
+        mSlotFreed.wakeOne();
+}
+
+bool ConnectionPool::closeDue(const PooledConnection* connection) const
+{
+    QMutexLocker poolLocker(&mMutex);
+    return connection->evicted || (!connection->leased && connection->idleTimer.hasExpired(mIdleTimeout.count()));
+}
+
+bool ConnectionPool::forget(PooledConnection* connection)
+{
+    // Whoever removes the connection from the pool closes it, false if someone else did so already
+    QMutexLocker poolLocker(&mMutex);
+    if(connection->evicted)
+        return false;
+
+    connection->evicted = true;
+    mConnections.removeIf([connection](const std::shared_ptr<PooledConnection>& c){ return c.get() == connection; });
+    mSlotFreed.wakeOne();
+    return true;
+}
+
+std::shared_ptr<PooledConnection> ConnectionPool::evictLongestIdle()
+{
+    // NOTE: Caller must hold mMutex, and close the returned connection (if any)
+    auto longestIdle = mConnections.end();
+    for(auto itr = mConnections.begin(); itr != mConnections.end(); itr++)
+        if(!(*itr)->leased && (longestIdle == mConnections.end() || (*itr)->idleTimer.elapsed() > (*longestIdle)->idleTimer.elapsed()))
+            longestIdle = itr;
+
+    if(longestIdle == mConnections.end())
+        return nullptr;
+
+    std::shared_ptr<PooledConnection> evicted = *longestIdle;
+    evicted->evicted = true;
+    mConnections.erase(longestIdle);
+    return evicted;
+}
+
+QList<std::shared_ptr<PooledConnection>> ConnectionPool::evictAllIdle()
+{
+    // Caller must close the returned connections
+    QList<std::shared_ptr<PooledConnection>> evicted;
+    QMutexLocker poolLocker(&mMutex);
+    mConnections.removeIf([&evicted](const std::shared_ptr<PooledConnection>& c){
+        if(c->leased)
+            return false;
+
+        c->evicted = true;
+        evicted.append(c);
+        return true;
+    });
+
+    if(!evicted.isEmpty())
+        mSlotFreed.wakeAll();
+    return evicted;
+}
+
+//Public:
+QSqlError ConnectionPool::acquire(std::shared_ptr<PooledConnection>& connection)
+{
+    connection.reset();
+    ThreadConnections& local = ThreadConnections::local();
+    local.sweep(this);
+
+    // Share the connection the calling thread already holds, so that nested use can never wait on itself
+    if(ThreadConnections::Entry* entry = local.find(this))
+    {
+        if((connection = entry->lease.lock()))
+            return QSqlError();
+
+        // Leased in the same step as checking that no other thread evicted it
+        bool evicted;
+        {
+            QMutexLocker poolLocker(&mMutex);
+            evicted = entry->connection->evicted;
+            entry->connection->leased = !evicted;
+        }
+
+        if(!evicted)
+        {
+            connection = lease(entry->connection);
+            entry->lease = connection;
+            return QSqlError();
+        }
+
+        // Its slot was taken over, so line up for one like everyone else
+        local.close(this);
+    }
+
+    // Reserve a slot, taking one over from an idle connection if at the cap, but don't hold up the pool while opening
+    QString connectionName;
+    std::shared_ptr<PooledConnection> evicted;
+    {
+        QMutexLocker poolLocker(&mMutex);
+        QDeadlineTimer deadline(ACQUIRE_TIMEOUT);
+        while(mConnections.size() + mOpening >= mMaxSize && !(evicted = evictLongestIdle()))
+        {
+            mWaiting++;
+            bool woken = mSlotFreed.wait(&mMutex, deadline);
+            mWaiting--;
+            if(!woken)
+                return QSqlError(ERR_EXHAUSTED, {}, QSqlError::ConnectionError);
+        }
+
+        mOpening++;
+        connectionName = mNamePrefix + QString::number(mNameCounter++);
+    }
+
+    // Its owner only drops it once it notices
+    if(evicted)
+        destroy(evicted.get());
+
+    auto fresh = std::make_shared<PooledConnection>();
+    fresh->owner = std::this_thread::get_id();
+    fresh->leased = true;
+    QSqlError openError = mOpener(*fresh, connectionName);
+
+    {
+        QMutexLocker poolLocker(&mMutex);
+        mOpening--;
+        if(openError.isValid())
+        {
+            mSlotFreed.wakeOne();
+            return openError;
+        }
+        mConnections.append(fresh);
+    }
+
+    ThreadConnections::Entry& entry = local.add(weak_from_this(), fresh);
+    connection = lease(fresh);
+    entry.lease = connection;
+
+    return QSqlError();
+}
+
+void ConnectionPool::closeIdle()
+{
+    // Includes connections of other threads, whose owners then just drop them
+    for(const std::shared_ptr<PooledConnection>& connection : evictAllIdle())
+        destroy(connection.get());
+    ThreadConnections::local().close(this); // Drops this thread's entry, if it was one of them
+}
+
+int ConnectionPool::size() const
+{
+    QMutexLocker poolLocker(&mMutex);
+    return mConnections.size();
+}
+
+int ConnectionPool::maxSize() const { return mMaxSize; }
+
+}
@@ -0,0 +1,106 @@
+#ifndef FLASHPOINT_CONNECTIONPOOL_H
+#define FLASHPOINT_CONNECTIONPOOL_H
+
+// Standard Library Includes
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+
+// Qt Includes
+#include <QtSql>
+
+using namespace Qt::Literals::StringLiterals;
+
+namespace Fp
+{
+
+/* QtSql connections may only be used by the thread that opened them, so a pooled connection is only ever leased to
+ * that thread. Everything but the bookkeeping at the end is only touched by whoever holds a lease, and so needs no lock.
+ */
+struct PooledConnection
+{
+    QSqlDatabase database;
+    QHash<QString, QSqlQuery> statements; // Command -> Idle prepared statement
+    QStringList statementOrder; // Commands of idle statements, least recently used first
+    std::optional<qint64> dataVersion; // Last seen PRAGMA data_version, only comparable with later values from this connection
+    std::atomic<bool> closed = false; // Set by whichever thread closes it, its owner or one that evicted it
+
+    // Guarded by the pool
+    std::thread::id owner;
+    bool leased = false;
+    bool evicted = false; // Closed, or about to be, by a thread other than the owner, which only drops it
+    QElapsedTimer idleTimer;
+};
+
+/* Hands each thread one connection of its own, opened on first use and shared by nested acquisitions on that thread.
+ * The number of open connections across all threads is capped. Once at the cap, a thread without a connection evicts
+ * the connection that has been idle the longest, whichever thread it belongs to, and only waits if all of them are in
+ * use. Idle connections are also closed:
+ *
+ * - When the owning thread exits
+ * - When the owner next uses any pool after the connection was idle for longer than the idle timeout
+ * - On closeIdle(), from any thread
+ *
+ * Evicting from another thread is sound since a connection that isn't leased is touched by no one, and its owner
+ * checks under the pool's lock whether it's still there before leasing it again. QSQLITE's driver holds nothing bound
+ * to its thread besides the QObject itself, which receives no events.
+ */
+class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
+{
+    friend class ThreadConnections;
+//-Class Types-----------------------------------------------------------------------------------------------
+public:
+    using Opener = std::function<QSqlError(PooledConnection& connection, const QString& connectionName)>;
+
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static constexpr int ACQUIRE_TIMEOUT = 30000; // ms
+    static inline const QString ERR_EXHAUSTED = u"Timed out waiting for a free database connection."_s;
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    mutable QMutex mMutex;
+    QWaitCondition mSlotFreed;
+    const QString mNamePrefix;
+    const Opener mOpener;
+    const int mMaxSize;
+    const std::chrono::milliseconds mIdleTimeout;
+    quint64 mNameCounter;
+    int mOpening;
+    int mWaiting;
+    QList<std::shared_ptr<PooledConnection>> mConnections; // Open connections of all threads
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    ConnectionPool(const QString& namePrefix, const Opener& opener, int maxSize, std::chrono::milliseconds idleTimeout);
+
+//-Destructor-------------------------------------------------------------------------------------------------
+public:
+    ~ConnectionPool();
+
+//-Class Functions---------------------------------------------------------------------------------------------
+private:
+    static void destroy(PooledConnection* connection);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    std::shared_ptr<PooledConnection> lease(const std::shared_ptr<PooledConnection>& connection);
+    void release(PooledConnection* connection);
+    bool closeDue(const PooledConnection* connection) const;
+    bool forget(PooledConnection* connection);
+    std::shared_ptr<PooledConnection> evictLongestIdle();
+    QList<std::shared_ptr<PooledConnection>> evictAllIdle();
+
+public:
+    QSqlError acquire(std::shared_ptr<PooledConnection>& connection);
+    void closeIdle();
+    int size() const;
+    int maxSize() const;
+};
+
+}
+
+#endif // FLASHPOINT_CONNECTIONPOOL_H
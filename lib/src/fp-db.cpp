@@ -1,13 +1,114 @@
 // Unit Includes
 #include "fp/fp-db.h"
 
+// Standard Library Includes
+#include <string_view>
+
+// Qt Includes
+#include <QJsonArray>
+#include <QJsonDocument>
+
 // Qx Includes
 #include <qx/core/qx-string.h>
 #include <qx/core/qx-regularexpression.h>
 
+// Project Includes
+#include "fp/fp-dbview.h"
+#include "fp/fp-gamerecord.h"
+#include "fp/fp-snapshot.h"
+#include "fp/fp-tagindex.h"
+#include "fp/fp-tagdirectory.h"
+#include "fp-changetracker.h"
+#include "fp-connectionpool.h"
+#include "fp-itemcache.h"
+#include "fp-metadatacache.h"
+#include "fp-searchindex.h"
+#include "fp-stringpool.h"
+#ifdef FP_NATIVE_SQLITE
+#include "fp-nativereader.h"
+#endif
+
 namespace Fp
 {
 
+namespace
+{
+    // Set on threads of a Db's worker pool, which draw connections from that Db's worker connection pool
+    thread_local const Db* tWorkerOf = nullptr;
+
+    // Comparing QStringViews isn't constexpr, but their UTF-16 data is
+    template<std::size_t N>
+    constexpr bool columnAt(const std::array<QStringView, N>& columns, std::size_t ordinal, std::u16string_view name)
+    {
+        return ordinal < N && std::u16string_view(columns[ordinal].utf16(), columns[ordinal].size()) == name;
+    }
+}
+
+// Ordinals are positions in each table's column list, check that every one of them lands on the column it is named for
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_ID, u"id"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_PARENT_ID, u"parentGameId"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_TITLE, u"title"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_SERIES, u"series"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_DEVELOPER, u"developer"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_PUBLISHER, u"publisher"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_DATE_ADDED, u"dateAdded"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_DATE_MODIFIED, u"dateModified"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_BROKEN, u"broken"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_EXTREME, u"extreme"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_PLAY_MODE, u"playMode"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_STATUS, u"status"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_NOTES, u"notes"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_SOURCE, u"source"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_APP_PATH, u"applicationPath"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_LAUNCH_COMMAND, u"launchCommand"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_RELEASE_DATE, u"releaseDate"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_VERSION, u"version"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_ORIGINAL_DESC, u"originalDescription"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_LANGUAGE, u"language"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_LIBRARY, u"library"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_ORDER_TITLE, u"orderTitle"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_PLATFORM_NAME, u"platformName"));
+static_assert(columnAt(Db::Table_Game::COLUMNS, Db::Table_Game::ORD_RUFFLE_SUPPORT, u"ruffleSupport"));
+
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_ID, u"id"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_GAME_ID, u"gameId"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_TITLE, u"title"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_DATE_ADDED, u"dateAdded"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_SHA256, u"sha256"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_CRC32, u"crc32"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_PRES_ON_DISK, u"presentOnDisk"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_PATH, u"path"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_SIZE, u"size"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_PARAM, u"parameters"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_APP_PATH, u"applicationPath"));
+static_assert(columnAt(Db::Table_Game_Data::COLUMNS, Db::Table_Game_Data::ORD_LAUNCH_COMMAND, u"launchCommand"));
+
+static_assert(columnAt(Db::Table_Game_Redirect::COLUMNS, Db::Table_Game_Redirect::ORD_ID, u"id"));
+static_assert(columnAt(Db::Table_Game_Redirect::COLUMNS, Db::Table_Game_Redirect::ORD_SOURCE_ID, u"sourceId"));
+
+static_assert(columnAt(Db::Table_Add_App::COLUMNS, Db::Table_Add_App::ORD_ID, u"id"));
+static_assert(columnAt(Db::Table_Add_App::COLUMNS, Db::Table_Add_App::ORD_APP_PATH, u"applicationPath"));
+static_assert(columnAt(Db::Table_Add_App::COLUMNS, Db::Table_Add_App::ORD_AUTORUN, u"autoRunBefore"));
+static_assert(columnAt(Db::Table_Add_App::COLUMNS, Db::Table_Add_App::ORD_LAUNCH_COMMAND, u"launchCommand"));
+static_assert(columnAt(Db::Table_Add_App::COLUMNS, Db::Table_Add_App::ORD_NAME, u"name"));
+static_assert(columnAt(Db::Table_Add_App::COLUMNS, Db::Table_Add_App::ORD_WAIT_EXIT, u"waitForExit"));
+static_assert(columnAt(Db::Table_Add_App::COLUMNS, Db::Table_Add_App::ORD_PARENT_ID, u"parentGameId"));
+
+static_assert(columnAt(Db::Table_Game_Tags_Tag::COLUMNS, Db::Table_Game_Tags_Tag::ORD_GAME_ID, u"gameId"));
+static_assert(columnAt(Db::Table_Game_Tags_Tag::COLUMNS, Db::Table_Game_Tags_Tag::ORD_TAG_ID, u"tagId"));
+
+static_assert(columnAt(Db::Table_Tag::COLUMNS, Db::Table_Tag::ORD_ID, u"id"));
+static_assert(columnAt(Db::Table_Tag::COLUMNS, Db::Table_Tag::ORD_PRIMARY_ALIAS_ID, u"primaryAliasId"));
+static_assert(columnAt(Db::Table_Tag::COLUMNS, Db::Table_Tag::ORD_CATEGORY_ID, u"categoryId"));
+
+static_assert(columnAt(Db::Table_Tag_Alias::COLUMNS, Db::Table_Tag_Alias::ORD_ID, u"id"));
+static_assert(columnAt(Db::Table_Tag_Alias::COLUMNS, Db::Table_Tag_Alias::ORD_TAG_ID, u"tagId"));
+static_assert(columnAt(Db::Table_Tag_Alias::COLUMNS, Db::Table_Tag_Alias::ORD_NAME, u"name"));
+
+static_assert(columnAt(Db::Table_Tag_Category::COLUMNS, Db::Table_Tag_Category::ORD_ID, u"id"));
+static_assert(columnAt(Db::Table_Tag_Category::COLUMNS, Db::Table_Tag_Category::ORD_NAME, u"name"));
+static_assert(columnAt(Db::Table_Tag_Category::COLUMNS, Db::Table_Tag_Category::ORD_COLOR, u"color"));
+
 //===============================================================================================================
 // DbError
 //===============================================================================================================
@@ -48,81 +149,272 @@ QString DbError::details() const { return mDetails; }
 
 
 //===============================================================================================================
-// DB::TAG_CATEGORY
+// DB::QUERY_BUFFER
 //===============================================================================================================
 
-//-Operators----------------------------------------------------------------------------------------------------
+//-Constructor------------------------------------------------------------------------------------------------
 //Public:
-bool operator< (const Db::TagCategory& lhs, const Db::TagCategory& rhs) noexcept { return lhs.name < rhs.name; }
+Db::QueryBuffer::QueryBuffer() :
+    mFirstPending(false),
+    mOnRecord(false),
+    mVisited(0)
+{}
 
-//===============================================================================================================
-// DB
-//===============================================================================================================
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Private:
+void Db::QueryBuffer::setResult(const std::shared_ptr<PooledConnection>& connection, const QString& source, QSqlQuery&& result,
+                                const QString& sizeCommand, const QVariantMap& sizeBindings)
+{
+    mConnection = connection;
+    mSource = source;
+    mResult = std::move(result);
+    mSizeCommand = sizeCommand;
+    mSizeBindings = sizeBindings;
+    mSize.reset();
+
+    // Step onto the first record ahead of time so that emptiness is known without a separate count
+    mOnRecord = mResult.next();
+    mFirstPending = true;
+    mVisited = mOnRecord ? 1 : 0;
+}
 
-//-Constructor------------------------------------------------------------------------------------------------
 //Public:
-Db::Db(const QString& databaseName, const Key&) :
-    QObject(),
-    mValid(false), // Instance is invalid until proven otherwise
-    mDatabaseName(databaseName)
+void Db::QueryBuffer::swap(QueryBuffer& other) noexcept
 {
-    QScopeGuard validityGuard([this](){ nullify(); }); // Automatically nullify on fail
+    std::swap(mConnection, other.mConnection);
+    std::swap(mSource, other.mSource);
+    mResult.swap(other.mResult);
+    std::swap(mFirstPending, other.mFirstPending);
+    std::swap(mOnRecord, other.mOnRecord);
+    std::swap(mVisited, other.mVisited);
+    std::swap(mSizeCommand, other.mSizeCommand);
+    std::swap(mSizeBindings, other.mSizeBindings);
+    std::swap(mSize, other.mSize);
+}
 
-    // Error tracker
-    QSqlError databaseError;
+bool Db::QueryBuffer::isNull() const { return mSource.isNull(); }
+bool Db::QueryBuffer::isEmpty() const { return mVisited == 0; }
+bool Db::QueryBuffer::isValid() const { return !mFirstPending && mOnRecord; }
+QString Db::QueryBuffer::source() const { return mSource; }
 
-    // Ensure required database tables are present
-    QSet<QString> missingTables;
-    if((databaseError = checkDatabaseForRequiredTables(missingTables)).isValid())
-    {
-        mError = DbError(DbError::SqlError, databaseError.text());
-        return;
-    }
+DbError Db::QueryBuffer::size(int& resultBuffer) const
+{
+    // Default return buffer to unknown
+    resultBuffer = -1;
 
-    // Check if tables are missing
-    if(!missingTables.isEmpty())
+    if(mSize)
     {
-        mError = DbError(DbError::InvalidSchema, ERR_MISSING_TABLE,
-                         QStringList(missingTables.begin(), missingTables.end()).join(u"\n"_s));
-        return;
+        resultBuffer = *mSize;
+        return DbError();
     }
 
-    // Ensure the database contains the required columns
-    QSet<QString> missingColumns;
-    if((databaseError = checkDatabaseForRequiredColumns(missingColumns)).isValid())
+    // Cheap cases, no result, or the result has already been walked in full
+    if(isNull())
     {
-        mError = DbError(DbError::SqlError, databaseError.text());
-        return;
+        resultBuffer = 0;
+        return DbError();
     }
-
-    // Check if columns are missing
-    if(!missingColumns.isEmpty())
+    if(isEmpty() || (!mFirstPending && !mOnRecord))
     {
-        mError = DbError(DbError::InvalidSchema, ERR_MISSING_TABLE,
-                         QStringList(missingColumns.begin(), missingColumns.end()).join(u"\n"_s));
-        return;
+        mSize = mVisited;
+        resultBuffer = *mSize;
+        return DbError();
     }
 
-    // Populate item members
-    if((databaseError = populateAvailableItems()).isValid())
+    // Otherwise count on the same connection as the result, only now that it's actually needed
+    if(mSizeCommand.isEmpty())
+        return DbError(DbError::Unsupported, ERR_NO_SIZE_COMMAND, mSource);
+
+    QSqlQuery sizeQuery(mResult.driver()->createResult());
+    sizeQuery.setForwardOnly(true);
+    if(!sizeQuery.prepare(mSizeCommand))
+        return DbError::fromSqlError(sizeQuery.lastError());
+
+    for(const auto [placeholder, value] : mSizeBindings.asKeyValueRange())
+        sizeQuery.bindValue(placeholder, value);
+
+    if(!sizeQuery.exec())
+        return DbError::fromSqlError(sizeQuery.lastError());
+    if(!sizeQuery.next())
+        return DbError::fromSqlError(sizeQuery.lastError().isValid() ? sizeQuery.lastError() :
+                                     QSqlError(ERR_NO_SIZE_RESULT, mSizeCommand, QSqlError::StatementError));
+
+    mSize = sizeQuery.value(0).toInt();
+    resultBuffer = *mSize;
+    return DbError();
+}
+
+bool Db::QueryBuffer::next()
+{
+    // First record was already fetched when the result was set
+    if(mFirstPending)
     {
-        mError = DbError(DbError::SqlError, databaseError.text());
-        return;
+        mFirstPending = false;
+        return mOnRecord;
     }
 
-    if((databaseError = populateTags()).isValid())
+    if(!mOnRecord)
+        return false;
+
+    if((mOnRecord = mResult.next()))
+        mVisited++;
+
+    return mOnRecord;
+}
+
+QVariant Db::QueryBuffer::value(int index) const { return mResult.value(index); }
+QVariant Db::QueryBuffer::value(const QString& name) const { return mResult.value(name); }
+QSqlRecord Db::QueryBuffer::record() const { return mResult.record(); }
+
+//-Operators----------------------------------------------------------------------------------------------------
+//Public:
+Db::QueryBuffer& Db::QueryBuffer::operator=(const QueryBuffer& other)
+{
+    // Same as below
+    QueryBuffer incoming(other);
+    swap(incoming);
+    return *this;
+}
+
+Db::QueryBuffer& Db::QueryBuffer::operator=(QueryBuffer&& other) noexcept
+{
+    /* Swap so that the previous contents are destroyed along with incoming, where the result is always released
+     * before its connection can be handed back to the pool
+     */
+    QueryBuffer incoming(std::move(other));
+    swap(incoming);
+    return *this;
+}
+
+//===============================================================================================================
+// DB::TAG_CATEGORY
+//===============================================================================================================
+
+//-Operators----------------------------------------------------------------------------------------------------
+//Public:
+bool operator< (const Db::TagCategory& lhs, const Db::TagCategory& rhs) noexcept { return lhs.name < rhs.name; }
+
+//===============================================================================================================
+// DB::METADATA
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+Db::Metadata::Metadata() :
+    tagDirectory(std::make_shared<const TagDirectory>())
+{}
+
+//===============================================================================================================
+// DB::CONNECTION_PROFILE
+//===============================================================================================================
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Public:
+Db::ConnectionProfile Db::ConnectionProfile::readOptimized()
+{
+    return {
+        .readOnly = false,
+        .immutable = false,
+        .queryOnly = true,
+        .tempStoreMemory = true,
+        .mmapSize = 256ll * 1024 * 1024,
+        .cacheSize = 64 * 1024
+    };
+}
+
+//===============================================================================================================
+// DB
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+Db::Db(const QString& databaseName, const ConnectionProfile& profile, const Key&) :
+    QObject(),
+    mValid(false), // Instance is invalid until proven otherwise
+    mDatabaseName(databaseName),
+    mProfile(profile),
+    mMetadata(std::make_shared<const Metadata>()),
+    mStatementCacheHits(0),
+    mStatementCacheMisses(0),
+    mItemCache(std::make_unique<ItemCache>()),
+    mSearchIndexGeneration(0)
+{
+    QScopeGuard validityGuard([this](){ nullify(); }); // Automatically nullify on fail
+
+    // Setup read connections
+    auto opener = [this](PooledConnection& connection, const QString& connectionName){
+        return openConnection(connection.database, connectionName, false);
+    };
+    /* Workers get a pool of their own, so that synchronous callers never wait on background work for a connection,
+     * nor the reverse. Each worker thread keeps its connection until the thread expires.
+     */
+    int workerCount = std::max(1, mProfile.maxConnections / 2);
+    mWorkers.setMaxThreadCount(workerCount);
+    mWorkers.setExpiryTimeout(static_cast<int>(mProfile.idleTimeout.count()));
+    mWorkerPool = std::make_shared<ConnectionPool>(connectionNamePrefix() + u"_w"_s, opener, workerCount, mProfile.idleTimeout);
+    mConnectionPool = std::make_shared<ConnectionPool>(connectionNamePrefix() + u"_r"_s, opener, std::max(1, mProfile.maxConnections - workerCount),
+                                                       mProfile.idleTimeout);
+
+    // Write connections are opened per thread as well, writes themselves are serialized by mWriteMutex
+    auto writeOpener = [this](PooledConnection& connection, const QString& connectionName){
+        return openConnection(connection.database, connectionName, true);
+    };
+    mWritePool = std::make_shared<ConnectionPool>(connectionNamePrefix() + u"_write"_s, writeOpener, mProfile.maxConnections, mProfile.idleTimeout);
+
+#ifdef FP_NATIVE_SQLITE
+    mNativeReaders = std::make_shared<NativeReaderPool>(mDatabaseName, mProfile);
+#endif
+
+    // Identify the file before touching it, so that the saved cache can't claim changes made meanwhile
+    std::optional<MetadataCache::Stamp> fileStamp = MetadataCache::stampOf(mDatabaseName);
+    if(!mProfile.metadataCachePath.isEmpty())
+        mMetadataCache = std::make_unique<MetadataCache>(mProfile.metadataCachePath, mDatabaseName);
+    std::optional<MetadataCache::Stamp> cacheStamp = mMetadataCache ? fileStamp : std::nullopt;
+
+    /* Metadata, cached or read from here on, is at least as new as the file as stamped, which is the tracker's
+     * baseline. So no data_version needs to be read yet, the first refresh compares the file against that stamp and
+     * changes made meanwhile show up as a newer generation.
+     */
+    if(!mProfile.immutable)
     {
-        mError = DbError(DbError::SqlError, databaseError.text());
-        return;
+        mChangeTracker = std::make_unique<ChangeTracker>(mDatabaseName, fileStamp);
+        mMetadataGeneration = ChangeTracker::BASELINE_GENERATION;
     }
 
-    // Populate game redirects
-    if((databaseError = populateGameRedirects()).isValid())
+    // Metadata from a previous run can be reused if the file is unchanged, it was only saved if the schema was valid
+    if(std::shared_ptr<const Metadata> cached = cacheStamp ? mMetadataCache->load(*cacheStamp) : nullptr)
+        mMetadata = std::move(cached);
+    else
     {
-        mError = DbError(DbError::SqlError, databaseError.text());
-        return;
+        // Ensure the database has the required tables and columns
+        if((mError = validateSchema()).isValid())
+            return;
+
+        // Populate metadata, readers wait for it instead of finding it empty
+        mMetadataLoad = startPhase([this, cacheStamp]{
+            std::shared_ptr<const Metadata> metadata;
+            if(QSqlError populateError = populateMetadata(metadata); populateError.isValid())
+            {
+                mMetadataError = DbError(DbError::SqlError, populateError.text());
+                return;
+            }
+
+            if(cacheStamp)
+                mMetadataCache->save(*metadata, *cacheStamp);
+            mMetadata = std::move(metadata);
+        });
+
+        if(!mProfile.deferMetadata && (mError = waitForMetadata()).isValid())
+            return;
     }
 
+    // Setup refresh, changes to the file are batched since one commit can touch it several times
+    mRefreshTimer.setSingleShot(true);
+    mRefreshTimer.setInterval(REFRESH_DEBOUNCE_MS);
+    connect(&mRefreshTimer, &QTimer::timeout, this, [this]{ startWork([this]{ refreshMetadata(); }); });
+    connect(&mFileWatcher, &QFileSystemWatcher::fileChanged, this, &Db::fileChangeHandler);
+    connect(&mFileWatcher, &QFileSystemWatcher::directoryChanged, this, &Db::fileChangeHandler);
+
     // Give the ok
     mValid = true;
     validityGuard.dismiss();
@@ -132,131 +424,482 @@ Db::Db(const QString& databaseName, const Key&) :
 //Public:
 Db::~Db()
 {
-    closeAllConnections();
+    // Drop queued work and wait out running tasks, pending futures are canceled
+    mWorkers.clear();
+    mWorkers.waitForDone();
+
+    mSearchIndex.reset();
+    mConnectionPool.reset(); // Connections still leased by buffers close once those are done
+    mWorkerPool.reset();
+    mWritePool.reset();
 }
 
 //-Class Functions--------------------------------------------------------------------------------------------
 //Private:
-QString Db::threadConnectionName(const QThread* thread)
+QString Db::idSetJson(const QList<QUuid>& ids)
+{
+    if(ids.isEmpty())
+        return u"[]"_s;
+
+    return u"[\""_s + Qx::String::join(ids, [](const QUuid& id){ return id.toString(QUuid::WithoutBraces); }, u"\",\""_s) + u"\"]"_s;
+}
+
+QString Db::idSetFilter(const QString& column, const QString& placeholder)
+{
+    // Keeps the command text the same no matter how many IDs are in the set
+    return column + u" IN (SELECT value FROM json_each("_s + placeholder + u"))"_s;
+}
+
+QString Db::redirectCte(const QString& placeholder)
 {
-    // Important to also salt using instance "id" so that
-    // different instances don't use the same connection
-   return DATABASE_CONNECTION_NAME +
-           u"_i"_s + QString::number((quint64)this, 16) +
-           u"_t"_s + QString::number((quint64)thread, 16);
+    /* Resolves each ID in the bound set through any chain of redirects, as REDIRECT_TARGET(requestedId, targetId, hops).
+     * IDs without a redirect resolve to themselves, and each keeps the deepest hop reached, which is the end of its chain
+     * (SQLite fills bare columns from the row MAX() picked). A hop is only taken away from an ID that isn't a game, so a game
+     * that is still present resolves to itself even if it is also the source of a redirect, and chains stop at the first one.
+     */
+    const QString& R = Table_Game_Redirect::NAME;
+    return u"WITH RECURSIVE redirect_hop(requestedId, targetId, hops) AS ("_s
+           u"SELECT value, value, 0 FROM json_each("_s + placeholder + u") UNION "_s
+           u"SELECT redirect_hop.requestedId, "_s + R + '.' + Table_Game_Redirect::COL_ID + u", redirect_hop.hops + 1 FROM redirect_hop JOIN "_s + R +
+           u" ON "_s + R + '.' + Table_Game_Redirect::COL_SOURCE_ID + u" = redirect_hop.targetId WHERE redirect_hop.hops < "_s + QString::number(MAX_REDIRECT_HOPS) +
+           u" AND NOT EXISTS (SELECT 1 FROM "_s + Table_Game::NAME + u" WHERE "_s + Table_Game::NAME + '.' + Table_Game::COL_ID + u" = redirect_hop.targetId)"_s
+           u"), "_s + REDIRECT_TARGET + u"(requestedId, targetId, hops) AS (SELECT requestedId, targetId, MAX(hops) FROM redirect_hop GROUP BY requestedId) "_s;
 }
 
+QString Db::redirectedIdSetFilter(const QString& column, const QString& placeholder)
+{
+    // Same as idSetFilter(), but matches what the IDs redirect to
+    return column + u" IN ("_s + redirectCte(placeholder) + u"SELECT targetId FROM "_s + REDIRECT_TARGET + u")"_s;
+}
+
+QString Db::makeGameFilter(QVariantMap& bindingsBuffer, const InclusionOptions& inclusionOptions, std::optional<const QList<QUuid>*> idInclusionFilter)
+{
+    // Handle filtering, sets are bound once as JSON arrays so the command stays the same size regardless of their length
+    QString filter = inclusionOptions.includeAnimations ? GAME_AND_ANIM_FILTER : GAME_ONLY_FILTER;
+
+    // Exclude games with excluded tags via anti-join instead of pulling their IDs out first
+    if(!inclusionOptions.excludedTagIds.isEmpty())
+    {
+        filter += u" AND NOT EXISTS (SELECT 1 FROM "_s + Table_Game_Tags_Tag::NAME + u" WHERE "_s +
+                  Table_Game_Tags_Tag::NAME + '.' + Table_Game_Tags_Tag::COL_GAME_ID + u" = "_s + Table_Game::NAME + '.' + Table_Game::COL_ID +
+                  u" AND "_s + Table_Game_Tags_Tag::NAME + '.' + Table_Game_Tags_Tag::COL_TAG_ID + u" IN (SELECT value FROM json_each(:excludedTagIds)))"_s;
+        bindingsBuffer[u":excludedTagIds"_s] = u"["_s + Qx::String::join(inclusionOptions.excludedTagIds, [](int tagId){ return QString::number(tagId); }, u","_s) + u"]"_s;
+    }
+
+    if(idInclusionFilter.has_value())
+    {
+        filter += u" AND "_s + redirectedIdSetFilter(Table_Game::COL_ID, u":includedIds"_s);
+        bindingsBuffer[u":includedIds"_s] = idSetJson(*idInclusionFilter.value());
+    }
+
+    return filter;
+}
+
+QString Db::singleLine(QString text)
+{
+    // Line breaks are rare, so only pay for the expression when there might be one
+    static const auto isBreak = [](QChar c){
+        return c == '\n' || c == '\r' || c == '\v' || c == '\f' || c == u'\x85' ||
+               c == QChar(QChar::LineSeparator) || c == QChar(QChar::ParagraphSeparator);
+    };
+
+    if(std::any_of(text.cbegin(), text.cend(), isBreak))
+        text.remove(Qx::RegularExpression::LINE_BREAKS);
+
+    return text;
+}
+
+Game Db::buildGame(const QueryBuffer& buffer, int offset)
+{
+    using T = Table_Game;
+    auto v = [&](T::Ordinal column){ return buffer.value(offset + column); };
+
+    Game::Builder fpGb;
+    fpGb.wId(v(T::ORD_ID).toString());
+    fpGb.wTitle(singleLine(v(T::ORD_TITLE).toString()));
+    fpGb.wSeries(singleLine(v(T::ORD_SERIES).toString()));
+    fpGb.wDeveloper(singleLine(v(T::ORD_DEVELOPER).toString()));
+    fpGb.wPublisher(singleLine(v(T::ORD_PUBLISHER).toString()));
+    fpGb.wDateAdded(v(T::ORD_DATE_ADDED).toString());
+    fpGb.wDateModified(v(T::ORD_DATE_MODIFIED).toString());
+    fpGb.wBroken(v(T::ORD_BROKEN).toBool());
+    fpGb.wPlayMode(v(T::ORD_PLAY_MODE).toString());
+    fpGb.wStatus(v(T::ORD_STATUS).toString());
+    fpGb.wNotes(v(T::ORD_NOTES).toString());
+    fpGb.wSource(singleLine(v(T::ORD_SOURCE).toString()));
+    fpGb.wAppPath(v(T::ORD_APP_PATH).toString());
+    fpGb.wLaunchCommand(v(T::ORD_LAUNCH_COMMAND).toString());
+    fpGb.wReleaseDate(v(T::ORD_RELEASE_DATE).toString());
+    fpGb.wVersion(singleLine(v(T::ORD_VERSION).toString()));
+    fpGb.wOriginalDescription(v(T::ORD_ORIGINAL_DESC).toString());
+    fpGb.wLanguage(singleLine(v(T::ORD_LANGUAGE).toString()));
+    fpGb.wOrderTitle(singleLine(v(T::ORD_ORDER_TITLE).toString()));
+    fpGb.wLibrary(v(T::ORD_LIBRARY).toString());
+    fpGb.wPlatformName(v(T::ORD_PLATFORM_NAME).toString());
+    fpGb.wRuffleSupport(v(T::ORD_RUFFLE_SUPPORT).toString());
+
+    return fpGb.build();
+}
+
+AddApp Db::buildAddApp(const QueryBuffer& buffer, int offset)
+{
+    using T = Table_Add_App;
+    auto v = [&](T::Ordinal column){ return buffer.value(offset + column); };
+
+    AddApp::Builder fpAab;
+    fpAab.wId(v(T::ORD_ID).toString());
+    fpAab.wAppPath(v(T::ORD_APP_PATH).toString());
+    fpAab.wAutorunBefore(v(T::ORD_AUTORUN).toBool());
+    fpAab.wLaunchCommand(v(T::ORD_LAUNCH_COMMAND).toString());
+    fpAab.wName(singleLine(v(T::ORD_NAME).toString()));
+    fpAab.wWaitExit(v(T::ORD_WAIT_EXIT).toBool());
+    fpAab.wParentId(v(T::ORD_PARENT_ID).toString());
+
+    return fpAab.build();
+}
+
+GameData Db::buildGameData(const QueryBuffer& buffer, int offset)
+{
+    using T = Table_Game_Data;
+    auto v = [&](T::Ordinal column){ return buffer.value(offset + column); };
+
+    GameData::Builder fpGdb;
+    fpGdb.wId(v(T::ORD_ID).toUInt());
+    fpGdb.wGameId(v(T::ORD_GAME_ID).toString());
+    fpGdb.wTitle(v(T::ORD_TITLE).toString());
+    fpGdb.wDateAdded(v(T::ORD_DATE_ADDED).toString());
+    fpGdb.wSha256(v(T::ORD_SHA256).toString());
+    fpGdb.wCrc32(v(T::ORD_CRC32).toUInt());
+    fpGdb.wPresentOnDisk(v(T::ORD_PRES_ON_DISK).toBool());
+    fpGdb.wPath(v(T::ORD_PATH).toString());
+    fpGdb.wSize(v(T::ORD_SIZE).toUInt());
+    fpGdb.wRawParameters(v(T::ORD_PARAM).toString());
+    fpGdb.wAppPath(v(T::ORD_APP_PATH).toString());
+    fpGdb.wLaunchCommand(v(T::ORD_LAUNCH_COMMAND).toString());
+
+    return fpGdb.build();
+}
+
+Entry Db::buildPolymorphicEntry(const QueryBuffer& buffer)
+{
+    // See queryEntriesById() for layout
+    if(buffer.value(0).toInt() == 0)
+        return buildGame(buffer, 1);
+    else
+        return buildAddApp(buffer, 1 + Table_Game::ORD_COUNT);
+}
 
 //-Instance Functions------------------------------------------------------------------------------------------------
 //Private:
 void Db::nullify()
 {
-   mPlatformNames.clear();
-    mPlaylistList.clear();
-    mTagDirectory.clear();
+    mMetadata = std::make_shared<const Metadata>();
 }
 
-void Db::closeConnection(const QThread* thread)
+QString Db::connectionNamePrefix() const
 {
-    if(mConnectedThreads.contains(thread))
+    // Important to salt using instance "id" so that different instances don't use the same connections
+    return DATABASE_CONNECTION_NAME + u"_i"_s + QString::number((quint64)this, 16);
+}
+
+QSqlError Db::openConnection(QSqlDatabase& connection, const QString& connectionName, bool write)
+{
+    connection = QSqlDatabase::addDatabase(u"QSQLITE"_s, connectionName);
+
+    // Open mode
+    QStringList options;
+    if(!write && (mProfile.readOnly || mProfile.immutable))
+        options.append(u"QSQLITE_OPEN_READONLY"_s);
+
+    if(!write && mProfile.immutable)
     {
-        QString tcn = threadConnectionName(thread);
+        // Only settable via URI; lets SQLite skip locking and change detection entirely
+        QUrl dbUrl = QUrl::fromLocalFile(QFileInfo(mDatabaseName).absoluteFilePath());
+        dbUrl.setQuery(u"immutable=1"_s);
+        options.append(u"QSQLITE_OPEN_URI"_s);
+        connection.setDatabaseName(dbUrl.toString(QUrl::FullyEncoded));
+    }
+    else
+        connection.setDatabaseName(mDatabaseName);
 
+    connection.setConnectOptions(options.join(';'));
+
+    QSqlError openError;
+    if(connection.open())
+    {
+        // Tuning, applied per connection
+        QStringList pragmas;
+        if(mProfile.mmapSize > 0)
+            pragmas.append(u"mmap_size = "_s + QString::number(mProfile.mmapSize));
+        if(mProfile.cacheSize > 0)
+            pragmas.append(u"cache_size = -"_s + QString::number(mProfile.cacheSize)); // Negative means KiB instead of pages
+        if(mProfile.tempStoreMemory)
+            pragmas.append(u"temp_store = MEMORY"_s);
+        if(!write && mProfile.queryOnly)
+            pragmas.append(u"query_only = ON"_s);
+
+        QSqlQuery pragmaQuery(connection);
+        for(const QString& pragma : std::as_const(pragmas))
         {
-            /* Scoped because the following QSqlDatabase instance must not exist when the database connection
-             * is removed, (as all connection instances must be deleted before using removeDatabase()), or else
-             * Qt will post a warning since any instances that remain then have a stale reference to the database.
-             */
-            QSqlDatabase connection = QSqlDatabase::database(tcn, false);
-            connection.close();
+            if(!pragmaQuery.exec(u"PRAGMA "_s + pragma))
+            {
+                openError = pragmaQuery.lastError();
+                break;
+            }
         }
 
-        QSqlDatabase::removeDatabase(tcn);
-        mConnectedThreads.remove(thread);
+        if(!openError.isValid())
+            return QSqlError();
     }
+    else
+        openError = connection.lastError();
+
+    /* Grab error first because I'm not sure if the QSqlDatabase instance
+     * is completely valid once its underlying connection is removed
+     */
+    connection.close();
+    connection = QSqlDatabase();
+    QSqlDatabase::removeDatabase(connectionName);
+    return openError;
+}
+
+QSqlError Db::getConnection(std::shared_ptr<PooledConnection>& connection)
+{
+    return (tWorkerOf == this ? mWorkerPool : mConnectionPool)->acquire(connection);
+}
+
+QSqlError Db::getWriteConnection(std::shared_ptr<PooledConnection>& connection)
+{
+    // NOTE: Acquire before taking mWriteMutex, waiting for a slot while holding it could stall the writer that frees one
+    return mWritePool->acquire(connection);
+}
+
+void Db::checkItemCacheCoherency()
+{
+    /* Any commit, including ones made through this instance's write connections, shows up as a new data generation.
+     * Checked on every lookup so that a cached item is never older than the last commit; the check is a single
+     * PRAGMA on the caller's own connection.
+     */
+    if(mProfile.immutable || !mItemCache->isEnabled())
+        return;
+
+    if(std::optional<quint64> generation = dataGeneration())
+        mItemCache->syncDataGeneration(*generation);
+}
+
+void Db::startWork(std::function<void()> work)
+{
+    mWorkers.start([this, work = std::move(work)]{
+        tWorkerOf = this;
+        work();
+    });
+}
+
+std::shared_ptr<Db::Phase> Db::startPhase(std::function<void()> work)
+{
+    auto phase = std::make_shared<Phase>();
+    phase->work = std::move(work);
+
+    startWork([phase]{
+        if(!phase->claimed.test_and_set())
+        {
+            phase->work();
+            phase->done.release();
+        }
+    });
+
+    return phase;
 }
 
-void Db::closeAllConnections()
+void Db::finishPhase(Phase& phase)
 {
-    QSet<const QThread*>::iterator i;
-    while(i != mConnectedThreads.end())
+    // Run it here if it's still queued, otherwise it's underway and will end
+    if(!phase.claimed.test_and_set())
+        phase.work();
+    else
+        phase.done.acquire();
+}
+
+void Db::runPhases(const QList<std::function<void()>>& phases)
+{
+    if(phases.isEmpty())
+        return;
+
+    // The caller takes the first phase instead of idling
+    QList<std::shared_ptr<Phase>> started;
+    for(auto itr = std::next(phases.cbegin()); itr != phases.cend(); itr++)
+        started.append(startPhase(*itr));
+
+    phases.first()();
+
+    for(const std::shared_ptr<Phase>& phase : std::as_const(started))
+        finishPhase(*phase);
+}
+
+std::shared_ptr<SearchIndex> Db::searchIndex()
+{
+    QMutexLocker searchLocker(&mSearchIndexMutex);
+
+    // Created on first use since building the index is costly and many users never search
+    if(!mSearchIndex)
     {
-        closeConnection(*i);
-        i = mConnectedThreads.erase(i);
+        QString connectionName = connectionNamePrefix() + u"_search"_s +
+                                 QString::number(mSearchIndexGeneration++); // Old index may still be in use
+        mSearchIndex = std::make_shared<SearchIndex>(mDatabaseName, mSearchIndexPath, connectionName, mProfile.maxConnections, mProfile.idleTimeout);
     }
+
+    return mSearchIndex;
 }
 
-QSqlError Db::getThreadConnection(QSqlDatabase& connection)
+QSqlError Db::prepareStatement(QSqlQuery& statement, PooledConnection& connection, const QString& command)
 {
-    QThread* thread = QThread::currentThread();
-    QString tcn = threadConnectionName(thread);
-
-    if(mConnectedThreads.contains(thread))
+    // Reuse an idle statement of the same shape from this connection if possible
+    if(connection.statements.contains(command))
     {
-        connection = QSqlDatabase::database(tcn, false);
+        statement = connection.statements.take(command);
+        connection.statementOrder.removeOne(command);
+        mStatementCacheHits++;
         return QSqlError();
     }
-    else
+
+    mStatementCacheMisses++;
+
+    statement = QSqlQuery(connection.database);
+    statement.setForwardOnly(true);
+    if(!statement.prepare(command))
+        return statement.lastError();
+
+    return QSqlError();
+}
+
+void Db::recycleStatement(QSqlQuery& statement, PooledConnection& connection)
+{
+    if(statement.lastQuery().isEmpty())
+        return;
+
+    // Release the result set and hand the statement back to this connection's cache
+    statement.finish();
+    QString command = statement.lastQuery();
+
+    if(!connection.statements.contains(command))
     {
-        connection = QSqlDatabase::addDatabase(u"QSQLITE"_s, tcn);
-        //connection.setConnectOptions("QSQLITE_OPEN_READONLY"); Lib features some DB writing now
-        connection.setDatabaseName(mDatabaseName);
+        // Make room by dropping whichever statement has gone unused the longest
+        if(connection.statements.size() >= STATEMENT_CACHE_CAPACITY)
+            connection.statements.remove(connection.statementOrder.takeFirst());
 
-        if(connection.open())
-        {
-            mConnectedThreads.insert(thread);
-            connect(thread, &QThread::destroyed, this, &Db::connectedThreadDestroyed);
-            return QSqlError();
-        }
-        else
-        {
-            /* Grab error first because I'm not sure if the QSqlDatabase instance
-             * is completely valid once its underlying connection is removed
-             */
-            QSqlError openError = connection.lastError();
-            QSqlDatabase::removeDatabase(tcn);
-            connection = QSqlDatabase();
-            return openError;
-        }
+        connection.statements.insert(command, std::move(statement));
+        connection.statementOrder.append(command);
     }
+
+    statement = QSqlQuery();
+}
+
+void Db::recycleStatement(QueryBuffer& buffer)
+{
+    if(buffer.mConnection)
+        recycleStatement(buffer.mResult, *buffer.mConnection);
+    buffer = QueryBuffer();
 }
 
-QSqlError Db::makeNonBindQuery(QueryBuffer& resultBuffer, QSqlDatabase* database, const QString& queryCommand, const QString& sizeQueryCommand) const
+QSqlError Db::makeQuery(QueryBuffer& resultBuffer, const std::shared_ptr<PooledConnection>& connection, const QString& source,
+                        const QString& queryCommand, const QString& sizeQueryCommand, const QVariantMap& bindings)
 {
-    // Create main query
-    QSqlQuery mainQuery(*database);
-    mainQuery.setForwardOnly(true);
-    mainQuery.prepare(queryCommand);
+    // Get main query
+    QSqlQuery mainQuery;
+    if(QSqlError prepError = prepareStatement(mainQuery, *connection, queryCommand); prepError.isValid())
+        return prepError;
+
+    for(const auto [placeholder, value] : bindings.asKeyValueRange())
+        mainQuery.bindValue(placeholder, value);
 
     // Execute query and return if error occurs
     if(!mainQuery.exec())
         return mainQuery.lastError();
 
-    // Create size query
-    QSqlQuery sizeQuery(*database);
-    sizeQuery.setForwardOnly(true);
-    sizeQuery.prepare(sizeQueryCommand);
+    // Set buffer instance to result, size query is deferred until requested
+    resultBuffer.setResult(connection, source, std::move(mainQuery), sizeQueryCommand, bindings);
 
-    // Execute query and return if error occurs
-    if(!sizeQuery.exec())
-        return sizeQuery.lastError();
+    // Return invalid SqlError
+    return QSqlError();
+}
 
-    // Get query size
-    sizeQuery.next();
-    int querySize = sizeQuery.value(0).toInt();
+#ifdef FP_NATIVE_SQLITE
+template<class View>
+DbError Db::forEachRow(const QString& command, const std::function<bool(const View&)>& visitor)
+{
+    // Uses its own handle since rows are read straight out of SQLite instead of through QtSql, kept per thread
+    std::shared_ptr<NativeReader> reader;
+    if(QSqlError openError = mNativeReaders->acquire(reader); openError.isValid())
+        return DbError::fromSqlError(openError);
+    if(QSqlError prepError = reader->prepare(command); prepError.isValid())
+        return DbError::fromSqlError(prepError);
+
+    View view(reader->row());
+    while(reader->step() && visitor(view)) {}
+
+    QSqlError stepError = reader->error();
+    reader->finish();
+    return DbError::fromSqlError(stepError);
+}
+#endif
 
-    // Set buffer instance to result
-    resultBuffer.result = std::move(mainQuery);
-    resultBuffer.size = querySize;
+DbError Db::queryEntriesById(QueryBuffer& resultBuffer, const QList<QUuid>& ids, bool followRedirects, int limit)
+{
+    /* Games and add apps are found in one statement via a union where each half is padded with the other's columns:
+     *
+     * [0] Priority (0 = game, 1 = add app)
+     * [1, 1 + game columns) Game columns
+     * [1 + game columns, end - 1) Add app columns
+     * [end - 1] Requested ID, which differs from the found ID if it was redirected
+     *
+     * Without followRedirects the IDs are matched directly and the redirect CTE is left out.
+     */
 
-    // Return invalid SqlError
-    return QSqlError();
+    // Ensure return buffer is effectively null
+    resultBuffer = QueryBuffer();
+
+    // Get database
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
+    if(dbError.isValid())
+        return DbError::fromSqlError(dbError);
+
+    // Make query
+    static const QString gameNulls = QStringList(Table_Game::COLUMN_LIST.size(), u"NULL"_s).join(',');
+    static const QString addAppNulls = QStringList(Table_Add_App::COLUMN_LIST.size(), u"NULL"_s).join(',');
+    auto requested = [followRedirects](const QString& table, const QString& idColumn){
+        return u","_s + (followRedirects ? REDIRECT_TARGET + u".requestedId"_s : table + '.' + idColumn) + u" FROM "_s + table;
+    };
+    auto idMatch = [followRedirects](const QString& table, const QString& idColumn){
+        QString column = table + '.' + idColumn;
+        return followRedirects ? u" JOIN "_s + REDIRECT_TARGET + u" ON "_s + column + u" = "_s + REDIRECT_TARGET + u".targetId"_s :
+                                 u" WHERE "_s + idSetFilter(column, u":ids"_s);
+    };
+    QString baseQueryCommand = (followRedirects ? redirectCte(u":ids"_s) : QString()) +
+                               u"SELECT 0 AS priority,`"_s + Table_Game::COLUMN_LIST.join(u"`,`"_s) + u"`,"_s + addAppNulls +
+                               requested(Table_Game::NAME, Table_Game::COL_ID) + idMatch(Table_Game::NAME, Table_Game::COL_ID) + u" UNION ALL "_s +
+                               u"SELECT 1 AS priority,"_s + gameNulls + u",`"_s + Table_Add_App::COLUMN_LIST.join(u"`,`"_s) + u"`"_s +
+                               requested(Table_Add_App::NAME, Table_Add_App::COL_ID) + idMatch(Table_Add_App::NAME, Table_Add_App::COL_ID);
+    QString mainQueryCommand = baseQueryCommand + u" ORDER BY priority"_s + (limit >= 0 ? u" LIMIT :limit"_s : QString());
+    QString sizeQueryCommand = u"SELECT "_s + GENERAL_QUERY_SIZE_COMMAND + u" FROM ("_s + mainQueryCommand + u")"_s;
+
+    QVariantMap bindings{{u":ids"_s, idSetJson(ids)}};
+    if(limit >= 0)
+        bindings[u":limit"_s] = limit;
+
+    return DbError::fromSqlError(makeQuery(resultBuffer, fpDb, Table_Game::NAME + u"|"_s + Table_Add_App::NAME, mainQueryCommand, sizeQueryCommand, bindings));
 }
 
 //Public:
 bool Db::isValid() { return mValid; }
 DbError Db::error() { return mError; }
 
+void Db::closeIdleConnections()
+{
+    mConnectionPool->closeIdle();
+    mWorkerPool->closeIdle();
+}
+
 QSqlError Db::checkDatabaseForRequiredTables(QSet<QString>& missingTablesReturnBuffer)
 {
     // Prep return buffer
@@ -266,16 +909,16 @@ QSqlError Db::checkDatabaseForRequiredTables(QSet<QString>& missingTablesReturnB
         missingTablesReturnBuffer.insert(tableAndColumns.name);
 
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return dbError;
 
-    QStringList existingTables = fpDb.tables();
+    QStringList existingTables = fpDb->database.tables();
 
     // Return if DB error occurred
-    if(fpDb.lastError().isValid())
-        return fpDb.lastError();
+    if(fpDb->database.lastError().isValid())
+        return fpDb->database.lastError();
 
     for(const QString& table : existingTables)
         missingTablesReturnBuffer.remove(table);
@@ -291,8 +934,8 @@ QSqlError Db::checkDatabaseForRequiredColumns(QSet<QString>& missingColumsReturn
     missingColumsReturnBuffer.clear();
 
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return dbError;
 
@@ -305,7 +948,7 @@ QSqlError Db::checkDatabaseForRequiredColumns(QSet<QString>& missingColumsReturn
         existingColumns.clear();
 
         // Make column name query
-        QSqlQuery columnQuery(u"PRAGMA table_info("_s + tableAndColumns.name + u")"_s, fpDb);
+        QSqlQuery columnQuery(u"PRAGMA table_info("_s + tableAndColumns.name + u")"_s, fpDb->database);
 
         // Return if error occurs
         if(columnQuery.lastError().isValid())
@@ -326,20 +969,48 @@ QSqlError Db::checkDatabaseForRequiredColumns(QSet<QString>& missingColumsReturn
     return QSqlError();
 }
 
-QSqlError Db::populateAvailableItems()
+DbError Db::validateSchema()
+{
+    // Error tracker
+    QSqlError databaseError;
+
+    // Ensure required database tables are present
+    QSet<QString> missingTables;
+    if((databaseError = checkDatabaseForRequiredTables(missingTables)).isValid())
+        return DbError(DbError::SqlError, databaseError.text());
+
+    // Check if tables are missing
+    if(!missingTables.isEmpty())
+        return DbError(DbError::InvalidSchema, ERR_MISSING_TABLE,
+                       QStringList(missingTables.begin(), missingTables.end()).join(u"\n"_s));
+
+    // Ensure the database contains the required columns
+    QSet<QString> missingColumns;
+    if((databaseError = checkDatabaseForRequiredColumns(missingColumns)).isValid())
+        return DbError(DbError::SqlError, databaseError.text());
+
+    // Check if columns are missing
+    if(!missingColumns.isEmpty())
+        return DbError(DbError::InvalidSchema, ERR_MISSING_TABLE,
+                       QStringList(missingColumns.begin(), missingColumns.end()).join(u"\n"_s));
+
+    return DbError();
+}
+
+QSqlError Db::populateAvailableItems(Metadata& metadata)
 {
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return dbError;
 
     // Ensure lists are reset
-    mPlatformNames.clear();
-    mPlaylistList.clear();
+    metadata.platformNames.clear();
+    metadata.playlistList.clear();
 
     // Make platform query
-    QSqlQuery platformQuery(u"SELECT DISTINCT "_s + Table_Game::COL_PLATFORM_NAME + u" FROM "_s + Table_Game::NAME, fpDb);
+    QSqlQuery platformQuery(u"SELECT DISTINCT "_s + Table_Game::COL_PLATFORM_NAME + u" FROM "_s + Table_Game::NAME, fpDb->database);
 
     // Return if error occurs
     if(platformQuery.lastError().isValid())
@@ -347,30 +1018,56 @@ QSqlError Db::populateAvailableItems()
 
     // Parse query
     while(platformQuery.next())
-        mPlatformNames.append(platformQuery.value(Table_Game::COL_PLATFORM_NAME).toString());
+        metadata.platformNames.append(StringPool::instance().intern(platformQuery.value(0).toString())); // Shared with games
 
     // Sort list
-    mPlatformNames.sort();
+    metadata.platformNames.sort();
 
     // Return invalid SqlError
     return QSqlError();
 }
 
-QSqlError Db::populateTags()
+QSqlError Db::tableFingerprint(size_t& resultBuffer, QSqlDatabase& connection, const QString& table, const QStringList& columns)
+{
+    // SQLite flattens the table into one ordered string, so only a single value has to cross over into Qt
+    resultBuffer = 0;
+    QString row = u"quote(`"_s + columns.join(u"`)||','||quote(`"_s) + u"`)"_s;
+    QSqlQuery fingerprintQuery(u"SELECT group_concat(r, char(30)) FROM (SELECT "_s + row + u" AS r FROM "_s + table + u" ORDER BY 1)"_s, connection);
+    if(!fingerprintQuery.next())
+        return fingerprintQuery.lastError();
+
+    resultBuffer = qHash(fingerprintQuery.value(0).toString());
+    return QSqlError();
+}
+
+QSqlError Db::populateTags(Metadata& metadata, const Metadata* previous)
 {
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return dbError;
 
-    // Ensure directory is reset
-    mTagDirectory.clear();
+    // The tag tables are small, so checking them first is cheap compared to rebuilding a directory that didn't change
+    size_t categories, aliases, tags;
+    if((dbError = tableFingerprint(categories, fpDb->database, Table_Tag_Category::NAME, Table_Tag_Category::COLUMN_LIST)).isValid() ||
+       (dbError = tableFingerprint(aliases, fpDb->database, Table_Tag_Alias::NAME, Table_Tag_Alias::COLUMN_LIST)).isValid() ||
+       (dbError = tableFingerprint(tags, fpDb->database, Table_Tag::NAME, Table_Tag::COLUMN_LIST)).isValid())
+        return dbError;
+
+    metadata.tagsFingerprint = qHashMulti(0, categories, aliases, tags);
+    if(previous && previous->tagsFingerprint == metadata.tagsFingerprint)
+    {
+        metadata.tagDirectory = previous->tagDirectory;
+        return QSqlError();
+    }
 
+    // Built off to the side, like the metadata it's part of
+    auto directory = std::make_shared<TagDirectory>();
     QMap<int, QString> tagAliasMap; // Tag Alias ID -> Tag Alias Name
 
     // Make tag category query
-    QSqlQuery categoryQuery(u"SELECT `"_s + Table_Tag_Category::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Tag_Category::NAME, fpDb);
+    QSqlQuery categoryQuery(u"SELECT `"_s + Table_Tag_Category::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Tag_Category::NAME, fpDb->database);
 
     // Return if error occurs
     if(categoryQuery.lastError().isValid())
@@ -379,15 +1076,13 @@ QSqlError Db::populateTags()
     // Parse query
     while(categoryQuery.next())
     {
-        TagCategory tc;
-        tc.name = categoryQuery.value(Table_Tag_Category::COL_NAME).toString();
-        tc.color = QColor(categoryQuery.value(Table_Tag_Category::COL_COLOR).toString());
-
-        mTagDirectory[categoryQuery.value(Table_Tag_Category::COL_ID).toInt()] = tc;
+        directory->addCategory(categoryQuery.value(Table_Tag_Category::ORD_ID).toInt(),
+                               categoryQuery.value(Table_Tag_Category::ORD_NAME).toString(),
+                               QColor(categoryQuery.value(Table_Tag_Category::ORD_COLOR).toString()));
     }
 
     // Make tag alias query
-    QSqlQuery aliasQuery(u"SELECT `"_s + Table_Tag_Alias::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Tag_Alias::NAME, fpDb);
+    QSqlQuery aliasQuery(u"SELECT `"_s + Table_Tag_Alias::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Tag_Alias::NAME, fpDb->database);
 
     // Return if error occurs
     if(aliasQuery.lastError().isValid())
@@ -395,10 +1090,10 @@ QSqlError Db::populateTags()
 
     // Parse query
     while(aliasQuery.next())
-        tagAliasMap[aliasQuery.value(Table_Tag_Alias::COL_ID).toInt()] = aliasQuery.value(Table_Tag_Alias::COL_NAME).toString();
+        tagAliasMap[aliasQuery.value(Table_Tag_Alias::ORD_ID).toInt()] = aliasQuery.value(Table_Tag_Alias::ORD_NAME).toString();
 
     // Make tag query
-    QSqlQuery tagQuery(u"SELECT `"_s + Table_Tag::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Tag::NAME, fpDb);
+    QSqlQuery tagQuery(u"SELECT `"_s + Table_Tag::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Tag::NAME, fpDb->database);
 
     // Return if error occurs
     if(tagQuery.lastError().isValid())
@@ -407,62 +1102,170 @@ QSqlError Db::populateTags()
     // Parse query
     while(tagQuery.next())
     {
-        // Create Tag
-        Tag tag;
-        tag.id = tagQuery.value(Table_Tag::COL_ID).toInt();
-        tag.primaryAlias = tagAliasMap.value(tagQuery.value(Table_Tag::COL_PRIMARY_ALIAS_ID).toInt());
-        int catId = tagQuery.value(Table_Tag::COL_CATEGORY_ID).toInt();
-        Q_ASSERT(mTagDirectory.contains(catId));
-        TagCategory& tc = mTagDirectory[catId];
-        tag.category = tc.name; // CoW reduces overhead
-
-        // Insert and add pointer to tag map
-        Tag& insertedTag = tc.tags.insert(tag.id, tag).value();
-        mTagMap[insertedTag.id] = &insertedTag;
+        int tagId = tagQuery.value(Table_Tag::ORD_ID).toInt();
+        int catId = tagQuery.value(Table_Tag::ORD_CATEGORY_ID).toInt();
+        if(!directory->addTag(tagId, tagAliasMap.value(tagQuery.value(Table_Tag::ORD_PRIMARY_ALIAS_ID).toInt()), catId))
+            qWarning("Table %s contains invalid category ID %d for tag %d", qPrintable(Table_Tag::NAME), catId, tagId);
     }
 
+    directory->seal();
+    metadata.tagDirectory = std::move(directory);
+
     // Return invalid SqlError
     return QSqlError();
 }
 
-QSqlError Db::populateGameRedirects()
+QSqlError Db::populateGameRedirects(Metadata& metadata, const Metadata* previous)
 {
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return dbError;
 
+    // Chains only need to be collapsed again if the redirects changed
+    size_t fingerprint;
+    if((dbError = tableFingerprint(fingerprint, fpDb->database, Table_Game_Redirect::NAME, Table_Game_Redirect::COLUMN_LIST)).isValid())
+        return dbError;
+
+    metadata.redirectsFingerprint = fingerprint;
+    if(previous && previous->redirectsFingerprint == fingerprint)
+    {
+        metadata.gameRedirects = previous->gameRedirects;
+        return QSqlError();
+    }
+
     // Ensure map is reset
-    mGameRedirects.clear();
+    metadata.gameRedirects.clear();
 
-    // Make redirect query
-    QSqlQuery redirectQuery(u"SELECT `"_s + Table_Game_Redirect::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Game_Redirect::NAME, fpDb);
+    // Make redirect query, skipping sources that are still games so that they resolve to themselves like in redirectCte()
+    QSqlQuery redirectQuery(u"SELECT `"_s + Table_Game_Redirect::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Game_Redirect::NAME +
+                            u" WHERE `"_s + Table_Game_Redirect::COL_SOURCE_ID + u"` NOT IN (SELECT `"_s + Table_Game::COL_ID + u"` FROM "_s + Table_Game::NAME + u")"_s,
+                            fpDb->database);
 
     // Return if error occurs
     if(redirectQuery.lastError().isValid())
         return redirectQuery.lastError();
 
     // Parse query
+    QHash<QUuid, QUuid> redirects;
     while(redirectQuery.next())
     {
-        QUuid src(redirectQuery.value(Table_Game_Redirect::COL_SOURCE_ID).toString());
+        QUuid src(redirectQuery.value(Table_Game_Redirect::ORD_SOURCE_ID).toString());
         if(src.isNull())
             continue;
 
-        QUuid dest(redirectQuery.value(Table_Game_Redirect::COL_ID).toString());
+        QUuid dest(redirectQuery.value(Table_Game_Redirect::ORD_ID).toString());
         if(dest.isNull())
             continue;
 
-        mGameRedirects[src] = dest;
+        redirects[src] = dest;
+    }
+
+    // Collapse chains so that each source maps straight to where it ends up, same as the bulk queries resolve them
+    metadata.gameRedirects.reserve(redirects.size());
+    for(auto [src, dest] : redirects.asKeyValueRange())
+    {
+        QUuid target = dest;
+        for(int hop = 1; hop < MAX_REDIRECT_HOPS; hop++)
+        {
+            auto next = redirects.constFind(target);
+            if(next == redirects.cend())
+                break;
+            target = next.value();
+        }
+        metadata.gameRedirects.insert(src, target);
     }
 
     // Return invalid SqlError
     return QSqlError();
 }
 
-DbError Db::queryGamesByPlatform(QList<QueryBuffer>& resultBuffer, const QStringList& platforms, const InclusionOptions& inclusionOptions,
-                                   std::optional<const QList<QUuid>*> idInclusionFilter)
+QSqlError Db::populateMetadata(std::shared_ptr<const Metadata>& metadata, const Metadata* previous)
+{
+    // Built off to the side, the result is only shared once complete. Parts that didn't change since previous are reused
+    auto fresh = std::make_shared<Metadata>();
+
+    // Each part fills its own members using its own connection, so they can be read side by side
+    QSqlError itemsError, tagsError, redirectsError;
+    runPhases({
+        [&]{ itemsError = populateAvailableItems(*fresh); },
+        [&]{ tagsError = populateTags(*fresh, previous); },
+        [&]{ redirectsError = populateGameRedirects(*fresh, previous); }
+    });
+
+    for(const QSqlError& populateError : {itemsError, tagsError, redirectsError})
+        if(populateError.isValid())
+            return populateError;
+
+    metadata = std::move(fresh);
+    return QSqlError();
+}
+
+std::shared_ptr<const Db::Metadata> Db::metadata() const
+{
+    // Holders keep their version alive, so it stays consistent even if a refresh happens meanwhile
+    QMutexLocker metadataLocker(&mMetadataMutex);
+    finishMetadataLoad();
+    return mMetadata;
+}
+
+DbError Db::metadata(std::shared_ptr<const Metadata>& resultBuffer) const
+{
+    // Same as above, but a failed deferred load is reported instead of passing off the empty metadata as the real thing
+    QMutexLocker metadataLocker(&mMetadataMutex);
+    finishMetadataLoad();
+    resultBuffer = mMetadata;
+    return mMetadataError;
+}
+
+void Db::finishMetadataLoad() const
+{
+    // Must hold the metadata mutex. The load only touches its result members, which are left alone until it's finished
+    if(mMetadataLoad)
+    {
+        finishPhase(*mMetadataLoad);
+        mMetadataLoad.reset();
+    }
+}
+
+std::optional<quint64> Db::dataGeneration()
+{
+    // Checked through the calling thread's own read connection, commits made through write connections count too
+    if(!mChangeTracker)
+        return std::nullopt;
+
+    std::shared_ptr<PooledConnection> fpDb;
+    if(getConnection(fpDb).isValid())
+        return std::nullopt;
+
+    quint64 generation;
+    if(mChangeTracker->check(generation, *fpDb).isValid())
+        return std::nullopt;
+
+    return generation;
+}
+
+void Db::watchFiles()
+{
+    /* Writes usually land in the WAL first, and replaced files drop out of the watch list. The WAL may only be created
+     * later (or be removed and recreated), so the directory is watched as well to pick it up when it appears.
+     */
+    QStringList paths{mDatabaseName};
+    if(QString walPath = mDatabaseName + WAL_SUFFIX; QFile::exists(walPath))
+        paths.append(walPath);
+
+    const QStringList watched = mFileWatcher.files();
+    for(const QString& path : paths)
+        if(!watched.contains(path))
+            mFileWatcher.addPath(path);
+
+    if(QString directory = QFileInfo(mDatabaseName).absolutePath(); !mFileWatcher.directories().contains(directory))
+        mFileWatcher.addPath(directory);
+}
+
+DbError Db::queryGamesByPlatform(std::vector<QueryBuffer>& resultBuffer, const QStringList& platforms, const InclusionOptions& inclusionOptions,
+                                 std::optional<const QList<QUuid>*> idInclusionFilter)
 {
     // Ensure return buffer is reset
     resultBuffer.clear();
@@ -472,95 +1275,114 @@ DbError Db::queryGamesByPlatform(QList<QueryBuffer>& resultBuffer, const QString
         return DbError();
 
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return DbError::fromSqlError(dbError);
 
-    // Determine game exclusion filter from tag exclusions if applicable
-    QSet<QUuid> idExclusionFilter;
-    if(!inclusionOptions.excludedTagIds.isEmpty())
-    {
-        // Make game tag sets query
-        QString tagIdCSV = Qx::String::join(inclusionOptions.excludedTagIds, [](int tagId){return QString::number(tagId);}, u"','"_s);
-        QSqlQuery tagQuery(u"SELECT `"_s + Table_Game_Tags_Tag::COL_GAME_ID + u"` FROM "_s + Table_Game_Tags_Tag::NAME +
-                           u" WHERE "_s + Table_Game_Tags_Tag::COL_TAG_ID + u" IN('"_s + tagIdCSV + u"')"_s, fpDb);
+    // Handle filtering
+    QVariantMap filterBindings;
+    QString gameFilter = makeGameFilter(filterBindings, inclusionOptions, idInclusionFilter);
 
-        QSqlError tagQueryError = tagQuery.lastError();
-        if(tagQueryError.isValid())
-            return DbError::fromSqlError(tagQueryError);
+    // Create platform query string
+    QString placeholder = u":platform"_s;
+    QString filteredQueryCommand = u"SELECT %1 FROM "_s + Table_Game::NAME + u" WHERE "_s +
+                                   Table_Game::COL_PLATFORM_NAME + u" = "_s + placeholder + u" AND "_s + gameFilter;
 
-        // Populate exclusion filter
-        while(tagQuery.next())
-            idExclusionFilter.insert(tagQuery.value(Table_Game_Tags_Tag::COL_GAME_ID).toUuid());
-    }
+    // Create final command strings
+    QString mainQueryCommand = filteredQueryCommand.arg(u"`"_s + Table_Game::COLUMN_LIST.join(u"`,`"_s) + u"`"_s);
+    QString sizeQueryCommand = filteredQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
 
     for(const QString& platform : platforms)
     {
-        // Create platform query string
-        QString placeholder = u":platform"_s;
-        QString baseQueryCommand = u"SELECT %1 FROM "_s + Table_Game::NAME + u" WHERE "_s +
-                                   Table_Game::COL_PLATFORM_NAME + u" = "_s + placeholder + u" AND "_s;
-
-        // Handle filtering
-        QString filteredQueryCommand = baseQueryCommand.append(inclusionOptions.includeAnimations ? GAME_AND_ANIM_FILTER : GAME_ONLY_FILTER);
-
-        if(!idExclusionFilter.isEmpty())
-        {
-            QString gameIdCSV = Qx::String::join(idExclusionFilter, [](QUuid id){return id.toString(QUuid::WithoutBraces);}, u"','"_s);
-            filteredQueryCommand += u" AND "_s + Table_Game::COL_ID + u" NOT IN('"_s + gameIdCSV + u"')"_s;
-        }
-
-        if(idInclusionFilter.has_value())
-        {
-            QString gameIdCSV = Qx::String::join(*idInclusionFilter.value(), [](QUuid id){return id.toString(QUuid::WithoutBraces);}, u"','"_s);
-            filteredQueryCommand += u" AND "_s + Table_Game::COL_ID + u" IN('"_s + gameIdCSV + u"')"_s;
-        }
-
-        // Create final command strings
-        QString mainQueryCommand = filteredQueryCommand.arg(u"`"_s + Table_Game::COLUMN_LIST.join(u"`,`"_s) + u"`"_s);
-        QString sizeQueryCommand = filteredQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
+        QVariantMap bindings = filterBindings;
+        bindings[placeholder] = platform;
 
         // Create main query and bind current platform
-        QSqlQuery initialQuery(fpDb);
-        initialQuery.setForwardOnly(true);
-        initialQuery.prepare(mainQueryCommand);
-        initialQuery.bindValue(placeholder, platform);
+        QSqlQuery initialQuery;
+        if(QSqlError prepError = prepareStatement(initialQuery, *fpDb, mainQueryCommand); prepError.isValid())
+            return DbError::fromSqlError(prepError);
+        for(const auto [ph, value] : bindings.asKeyValueRange())
+            initialQuery.bindValue(ph, value);
 
         // Execute query and return if error occurs
         if(!initialQuery.exec())
             return DbError::fromSqlError(initialQuery.lastError());
 
-        // Create size query and bind current platform
-        QSqlQuery sizeQuery(fpDb);
-        sizeQuery.prepare(sizeQueryCommand);
-        sizeQuery.bindValue(placeholder, platform);
-
-        // Execute query and return if error occurs
-        if(!sizeQuery.exec())
-            return DbError::fromSqlError(sizeQuery.lastError());
-
-        // Get query size
-        sizeQuery.next();
-        int querySize = sizeQuery.value(0).toInt();
-
-        // Add result to buffer if there were any hits
-        if(querySize > 0)
-            resultBuffer.append({platform, std::move(initialQuery), querySize});
+        // Add result to buffer if there were any hits (size query is deferred until requested)
+        QueryBuffer platformBuffer;
+        platformBuffer.setResult(fpDb, platform, std::move(initialQuery), sizeQueryCommand, bindings);
+        if(!platformBuffer.isEmpty())
+            resultBuffer.push_back(std::move(platformBuffer));
+        else
+            recycleStatement(platformBuffer);
     }
 
     // Return invalid error
     return DbError();
 }
 
+DbError Db::queryGamesByPlatform(QList<QueryBuffer>& resultBuffer, const QStringList& platforms, const InclusionOptions& inclusionOptions,
+                                 std::optional<const QList<QUuid>*> idInclusionFilter)
+{
+    // Kept for existing callers, each buffer holds onto the shared connection the same way
+    std::vector<QueryBuffer> buffers;
+    DbError queryError = queryGamesByPlatform(buffers, platforms, inclusionOptions, idInclusionFilter);
+
+    resultBuffer.clear();
+    resultBuffer.reserve(buffers.size());
+    for(QueryBuffer& buffer : buffers)
+        resultBuffer.append(std::move(buffer));
+
+    return queryError;
+}
+
+DbError Db::queryGamesByPlatform(QueryBuffer& resultBuffer, const QStringList& platforms, const InclusionOptions& inclusionOptions,
+                                 std::optional<const QList<QUuid>*> idInclusionFilter)
+{
+    /* Single pass variant that yields games from all platforms through one cursor, grouped (ordered) by platform.
+     * Callers can detect group boundaries via the platform name column.
+     */
+
+    // Ensure return buffer is effectively null
+    resultBuffer = QueryBuffer();
+
+    // Empty shortcuts
+    if(platforms.isEmpty() || (idInclusionFilter.has_value() && idInclusionFilter.value()->isEmpty()))
+        return DbError();
+
+    // Get database
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
+    if(dbError.isValid())
+        return DbError::fromSqlError(dbError);
+
+    // Handle filtering
+    QVariantMap bindings;
+    QString gameFilter = makeGameFilter(bindings, inclusionOptions, idInclusionFilter);
+
+    // Create query string, platforms are bound the same way as ID sets
+    QString placeholder = u":platforms"_s;
+    QString filteredQueryCommand = u"SELECT %1 FROM "_s + Table_Game::NAME + u" WHERE "_s +
+                                   Table_Game::COL_PLATFORM_NAME + u" IN (SELECT value FROM json_each("_s + placeholder + u")) AND "_s + gameFilter;
+    bindings[placeholder] = QString::fromUtf8(QJsonDocument(QJsonArray::fromStringList(platforms)).toJson(QJsonDocument::Compact));
+
+    // Create final command strings
+    QString mainQueryCommand = filteredQueryCommand.arg(u"`"_s + Table_Game::COLUMN_LIST.join(u"`,`"_s) + u"`"_s) +
+                               u" ORDER BY "_s + Table_Game::COL_PLATFORM_NAME;
+    QString sizeQueryCommand = filteredQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
+
+    return DbError::fromSqlError(makeQuery(resultBuffer, fpDb, Table_Game::NAME, mainQueryCommand, sizeQueryCommand, bindings));
+}
+
 DbError Db::queryAllAddApps(QueryBuffer& resultBuffer)
 {
     // Ensure return buffer is effectively null
     resultBuffer = QueryBuffer();
 
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return DbError::fromSqlError(dbError);
 
@@ -569,8 +1391,27 @@ DbError Db::queryAllAddApps(QueryBuffer& resultBuffer)
     QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Add_App::COLUMN_LIST.join(u"`,`"_s) + u"`"_s);
     QString sizeQueryCommand = baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
 
-    resultBuffer.source = Table_Add_App::NAME;
-    return DbError::fromSqlError(makeNonBindQuery(resultBuffer, &fpDb, mainQueryCommand, sizeQueryCommand));
+    return DbError::fromSqlError(makeQuery(resultBuffer, fpDb, Table_Add_App::NAME, mainQueryCommand, sizeQueryCommand));
+}
+
+DbError Db::queryAllEntryTags(QueryBuffer& resultBuffer)
+{
+    // Ensure return buffer is effectively null
+    resultBuffer = QueryBuffer();
+
+    // Get database
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
+    if(dbError.isValid())
+        return DbError::fromSqlError(dbError);
+
+    // Make query, grouped by game so that consumers can build each game's tags in one go
+    QString baseQueryCommand = u"SELECT %1 FROM "_s + Table_Game_Tags_Tag::NAME;
+    QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Game_Tags_Tag::COLUMN_LIST.join(u"`,`"_s) + u"`"_s) +
+                               u" ORDER BY "_s + Table_Game_Tags_Tag::COL_GAME_ID;
+    QString sizeQueryCommand = baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
+
+    return DbError::fromSqlError(makeQuery(resultBuffer, fpDb, Table_Game_Tags_Tag::NAME, mainQueryCommand, sizeQueryCommand));
 }
 
 DbError Db::queryEntrys(QueryBuffer& resultBuffer, const EntryFilter& filter)
@@ -578,14 +1419,39 @@ DbError Db::queryEntrys(QueryBuffer& resultBuffer, const EntryFilter& filter)
     // Ensure return buffer is effectively null
     resultBuffer = QueryBuffer();
 
-    // Query Constants
-    const QString where = u" WHERE "_s;
-    const QString nd = u" AND "_s;
-    const QString likeTempl = u" LIKE '%%1%' ESCAPE '\\'"_s;
+    // Query Constants
+    const QString where = u" WHERE "_s;
+    const QString nd = u" AND "_s;
+    const QString likeTempl = u" LIKE :name ESCAPE '\\'"_s;
+    const QString limitClause = filter.limit >= 0 ? u" LIMIT :limit"_s : QString();
+
+    // Bindings, shared by both tables and the size query
+    QVariantMap bindings;
+    if(!filter.id.isNull())
+        bindings[u":id"_s] = filter.id.toString(QUuid::WithoutBraces);
+    if(!filter.parent.isNull())
+        bindings[u":parent"_s] = filter.parent.toString(QUuid::WithoutBraces);
+    if(!filter.name.isNull())
+    {
+        if(filter.exactName)
+            bindings[u":name"_s] = filter.name;
+        else
+        {
+            // Escape name to account for SQL LITE %
+            QString escapedName = filter.name;
+            escapedName.replace(uR"(\)"_s, uR"(\\)"_s); // Have to escape the escape char
+            escapedName.replace(uR"(%)"_s, uR"(\%)"_s);
+
+            bindings[u":name"_s] = u"%"_s + escapedName + u"%"_s;
+        }
+    }
+
+    if(filter.limit >= 0)
+        bindings[u":limit"_s] = filter.limit;
 
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return DbError::fromSqlError(dbError);
 
@@ -600,42 +1466,32 @@ DbError Db::queryEntrys(QueryBuffer& resultBuffer, const EntryFilter& filter)
             baseQueryCommand += where;
 
             if(!filter.id.isNull())
-                baseQueryCommand += Table_Game::COL_ID + u" == '"_s + filter.id.toString(QUuid::WithoutBraces) + u"'"_s + nd;
+                baseQueryCommand += Table_Game::COL_ID + u" == :id"_s + nd;
             if(!filter.parent.isNull())
-                baseQueryCommand += Table_Game::COL_PARENT_ID + u" == '"_s + filter.parent.toString(QUuid::WithoutBraces) + u"'"_s + nd;
+                baseQueryCommand += Table_Game::COL_PARENT_ID + u" == :parent"_s + nd;
             if(!filter.name.isNull())
-            {
-                if(filter.exactName)
-                    baseQueryCommand += Table_Game::COL_TITLE + u" == '"_s + filter.name + u"'"_s + nd;
-                else
-                {
-                    // Escape name to account for SQL LITE %
-                    QString escapedName = filter.name;
-                    escapedName.replace(uR"(\)"_s, uR"(\\)"_s); // Have to escape the escape char
-                    escapedName.replace(uR"(%)"_s, uR"(\%)"_s);
-
-                    baseQueryCommand += Table_Game::COL_TITLE + likeTempl.arg(escapedName) + nd;
-                }
-            }
+                baseQueryCommand += Table_Game::COL_TITLE + (filter.exactName ? u" == :name"_s : likeTempl) + nd;
 
             // Remove trailing AND
             baseQueryCommand.chop(nd.size());
         }
 
         // Assemble final query commands
-        QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Game::COLUMN_LIST.join(u"`,`"_s) + u"`"_s);
-        QString sizeQueryCommand = baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
+        QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Game::COLUMN_LIST.join(u"`,`"_s) + u"`"_s) + limitClause;
+        QString sizeQueryCommand = limitClause.isEmpty() ? baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND) :
+                                   u"SELECT "_s + GENERAL_QUERY_SIZE_COMMAND + u" FROM ("_s + baseQueryCommand.arg(u"1"_s) + limitClause + u")"_s;
 
         // Make query
         QSqlError queryError;
-        resultBuffer.source = Table_Game::NAME;
-
-        if((queryError = makeNonBindQuery(resultBuffer, &fpDb, mainQueryCommand, sizeQueryCommand)).isValid())
+        if((queryError = makeQuery(resultBuffer, fpDb, Table_Game::NAME, mainQueryCommand, sizeQueryCommand, bindings)).isValid())
             return DbError::fromSqlError(queryError);
 
         // Return result if one or more results were found (receiver handles situation in latter case)
-        if(resultBuffer.size >= 1)
+        if(!resultBuffer.isEmpty())
             return DbError();
+
+        // Statement is no longer needed
+        recycleStatement(resultBuffer);
     }
 
     // Check for entry as an additional app second
@@ -649,23 +1505,11 @@ DbError Db::queryEntrys(QueryBuffer& resultBuffer, const EntryFilter& filter)
             baseQueryCommand += where;
 
             if(!filter.id.isNull())
-                baseQueryCommand += Table_Add_App::COL_ID + u" == '"_s + filter.id.toString(QUuid::WithoutBraces) + u"'"_s + nd;
+                baseQueryCommand += Table_Add_App::COL_ID + u" == :id"_s + nd;
             if(!filter.parent.isNull())
-                baseQueryCommand += Table_Add_App::COL_PARENT_ID + u" == '"_s + filter.parent.toString(QUuid::WithoutBraces) + u"'"_s + nd;
+                baseQueryCommand += Table_Add_App::COL_PARENT_ID + u" == :parent"_s + nd;
             if(!filter.name.isNull())
-            {
-                if(filter.exactName)
-                    baseQueryCommand += Table_Add_App::COL_NAME + u" == '"_s + filter.name + u"'"_s + nd;
-                else
-                {
-                    // Escape name to account for SQL LITE %
-                    QString escapedName = filter.name;
-                    escapedName.replace(uR"(\)"_s, uR"(\\)"_s); // Have to escape the escape char
-                    escapedName.replace(uR"(%)"_s, uR"(\%)"_s);
-
-                    baseQueryCommand += Table_Add_App::COL_NAME + likeTempl.arg(escapedName) + nd;
-                }
-            }
+                baseQueryCommand += Table_Add_App::COL_NAME + (filter.exactName ? u" == :name"_s : likeTempl) + nd;
             if(filter.playableOnly)
             {
                 baseQueryCommand += Table_Add_App::COL_APP_PATH + u" NOT IN ('"_s + Table_Add_App::ENTRY_EXTRAS + u"','"_s +
@@ -678,18 +1522,17 @@ DbError Db::queryEntrys(QueryBuffer& resultBuffer, const EntryFilter& filter)
         }
 
         // Assemble final query commands
-        QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Add_App::COLUMN_LIST.join(u"`,`"_s) + u"`"_s);
-        QString sizeQueryCommand = baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
+        QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Add_App::COLUMN_LIST.join(u"`,`"_s) + u"`"_s) + limitClause;
+        QString sizeQueryCommand = limitClause.isEmpty() ? baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND) :
+                                   u"SELECT "_s + GENERAL_QUERY_SIZE_COMMAND + u" FROM ("_s + baseQueryCommand.arg(u"1"_s) + limitClause + u")"_s;
 
         // Make query
         QSqlError queryError;
-        resultBuffer.source = Table_Add_App::NAME;
-
-        if((queryError = makeNonBindQuery(resultBuffer, &fpDb, mainQueryCommand, sizeQueryCommand)).isValid())
+        if((queryError = makeQuery(resultBuffer, fpDb, Table_Add_App::NAME, mainQueryCommand, sizeQueryCommand, bindings)).isValid())
             return DbError::fromSqlError(queryError);
 
         // Return result if one or more results were found (receiver handles situation in latter case)
-        if(resultBuffer.size >= 1)
+        if(!resultBuffer.isEmpty())
             return DbError();
     }
 
@@ -706,23 +1549,21 @@ DbError Db::queryEntryDataById(QueryBuffer& resultBuffer, const QUuid& appId)
     resultBuffer = QueryBuffer();
 
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return DbError::fromSqlError(dbError);
 
     // Setup ID query
     QString baseQueryCommand = u"SELECT %1 FROM "_s + Table_Game_Data::NAME + u" WHERE "_s +
-            Table_Game_Data::COL_GAME_ID + u" == '"_s + appId.toString(QUuid::WithoutBraces) + u"' "_s +
+            Table_Game_Data::COL_GAME_ID + u" == :gameId "_s +
                                u"ORDER BY "_s + Table_Game_Data::COL_DATE_ADDED + u" DESC"_s;
     QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Game_Data::COLUMN_LIST.join(u"`,`"_s) + u"`"_s);
     QString sizeQueryCommand = baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
 
     // Make query
-    QSqlError queryError;
-    resultBuffer.source = Table_Game_Data::NAME;
-
-    return DbError::fromSqlError(makeNonBindQuery(resultBuffer, &fpDb, mainQueryCommand, sizeQueryCommand));
+    return DbError::fromSqlError(makeQuery(resultBuffer, fpDb, Table_Game_Data::NAME, mainQueryCommand, sizeQueryCommand,
+                                           {{u":gameId"_s, appId.toString(QUuid::WithoutBraces)}}));
 }
 
 DbError Db::queryAllGameIds(QueryBuffer& resultBuffer, const LibraryFilter& includeFilter)
@@ -731,8 +1572,8 @@ DbError Db::queryAllGameIds(QueryBuffer& resultBuffer, const LibraryFilter& incl
     resultBuffer = QueryBuffer();
 
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return DbError::fromSqlError(dbError);
 
@@ -743,12 +1584,129 @@ DbError Db::queryAllGameIds(QueryBuffer& resultBuffer, const LibraryFilter& incl
     QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Game::COL_ID + u"`"_s);
     QString sizeQueryCommand = baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
 
-    resultBuffer.source = Table_Game::NAME;
-    return DbError::fromSqlError(makeNonBindQuery(resultBuffer, &fpDb, mainQueryCommand, sizeQueryCommand));
+    return DbError::fromSqlError(makeQuery(resultBuffer, fpDb, Table_Game::NAME, mainQueryCommand, sizeQueryCommand));
+}
+
+DbError Db::tagIndex(std::shared_ptr<const TagIndex>& resultBuffer)
+{
+    // Built on first use, concurrent callers wait on the same build
+    QMutexLocker indexLocker(&mTagIndexMutex);
+
+    if(!mTagIndex)
+    {
+        std::shared_ptr<TagIndex> index(new TagIndex());
+
+        // Game ordinals follow table order
+        {
+            std::shared_ptr<PooledConnection> fpDb;
+            if(QSqlError dbError = getConnection(fpDb); dbError.isValid())
+                return DbError::fromSqlError(dbError);
+
+            QSqlQuery idQuery(fpDb->database);
+            idQuery.setForwardOnly(true);
+            if(!idQuery.exec(u"SELECT `"_s + Table_Game::COL_ID + u"` FROM "_s + Table_Game::NAME))
+                return DbError::fromSqlError(idQuery.lastError());
+
+            while(idQuery.next())
+                index->addGame(QUuid(idQuery.value(0).toString()));
+        }
+
+        std::shared_ptr<const Metadata> md;
+        if(DbError metadataError = metadata(md); metadataError.isValid())
+            return metadataError;
+
+        for(const Tag& tag : md->tagDirectory->tags())
+            index->addTag(tag);
+
+        // Fill in membership in one pass over all pairs
+        DbError tagError = forEachEntryTag([&index](const QUuid& gameId, const Tag& tag){
+            index->addMembership(gameId, tag);
+            return true;
+        });
+        if(tagError.isValid())
+            return tagError;
+
+        index->seal();
+        mTagIndex = std::move(index);
+    }
+
+    resultBuffer = mTagIndex;
+    return DbError();
+}
+
+DbError Db::queryGameIdsByTagExpression(QList<QUuid>& resultBuffer, const QString& expression)
+{
+    // Ensure return buffer is reset
+    resultBuffer.clear();
+
+    std::shared_ptr<const TagIndex> index;
+    if(DbError indexError = tagIndex(index); indexError.isValid())
+        return indexError;
+
+    GameSet matches;
+    if(DbError exprError = index->evaluate(matches, expression); exprError.isValid())
+        return exprError;
+
+    resultBuffer = index->gameIds(matches);
+    return DbError();
+}
+
+DbError Db::searchEntrys(QList<QUuid>& resultBuffer, const QString& text, int limit)
+{
+    return DbError::fromSqlError(searchIndex()->search(resultBuffer, text, limit));
+}
+
+Db::ConnectionProfile Db::connectionProfile() const { return mProfile; }
+Db::StatementCacheStats Db::statementCacheStats() const { return {mStatementCacheHits, mStatementCacheMisses}; }
+Db::ItemCacheStats Db::itemCacheStats() const { return mItemCache->stats(); }
+
+QStringList Db::platformNames() const
+{
+    QStringList names;
+    if(DbError metadataError = platformNames(names); metadataError.isValid())
+        qWarning("Platform names are unavailable: %s", qPrintable(metadataError.cause()));
+    return names;
+}
+
+DbError Db::platformNames(QStringList& resultBuffer) const
+{
+    std::shared_ptr<const Metadata> md;
+    DbError metadataError = metadata(md);
+    resultBuffer = md->platformNames;
+    return metadataError;
+}
+
+std::shared_ptr<const TagDirectory> Db::tagDirectory() const
+{
+    std::shared_ptr<const TagDirectory> directory;
+    if(DbError metadataError = tagDirectory(directory); metadataError.isValid())
+        qWarning("Tags are unavailable: %s", qPrintable(metadataError.cause()));
+    return directory;
+}
+
+DbError Db::tagDirectory(std::shared_ptr<const TagDirectory>& resultBuffer) const
+{
+    std::shared_ptr<const Metadata> md;
+    DbError metadataError = metadata(md);
+    resultBuffer = md->tagDirectory;
+    return metadataError;
+}
+
+QMap<int, Db::TagCategory> Db::tags() const
+{
+    QMap<int, TagCategory> categories;
+    if(DbError metadataError = tags(categories); metadataError.isValid())
+        qWarning("Tags are unavailable: %s", qPrintable(metadataError.cause()));
+    return categories;
 }
 
-QStringList Db::platformNames() const { return mPlatformNames; } //TODO: Probably should use RAII for this.
-QMap<int, Db::TagCategory> Db::tags() const { return mTagDirectory; }
+DbError Db::tags(QMap<int, TagCategory>& resultBuffer) const
+{
+    std::shared_ptr<const TagDirectory> directory;
+    DbError metadataError = tagDirectory(directory);
+    resultBuffer = directory->toMap();
+    return metadataError;
+}
 
 DbError Db::entryUsesDataPack(bool& resultBuffer, const QUuid& gameId)
 {
@@ -770,18 +1728,19 @@ DbError Db::entryUsesDataPack(bool& resultBuffer, const QUuid& gameId)
     resultBuffer = false;
 
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
     if(dbError.isValid())
         return DbError::fromSqlError(dbError);
 
     // Make query
     QString packCheckQueryCommand = u"SELECT "_s + GENERAL_QUERY_SIZE_COMMAND + u" FROM "_s + Table_Game_Data::NAME + u" WHERE "_s +
-                                   Table_Game_Data::COL_GAME_ID + u" == '"_s + gameId.toString(QUuid::WithoutBraces) + u"'"_s;
+                                   Table_Game_Data::COL_GAME_ID + u" == :gameId"_s;
 
-    QSqlQuery packCheckQuery(fpDb);
-    packCheckQuery.setForwardOnly(true);
-    packCheckQuery.prepare(packCheckQueryCommand);
+    QSqlQuery packCheckQuery;
+    if(QSqlError prepError = prepareStatement(packCheckQuery, *fpDb, packCheckQueryCommand); prepError.isValid())
+        return DbError::fromSqlError(prepError);
+    packCheckQuery.bindValue(u":gameId"_s, gameId.toString(QUuid::WithoutBraces));
 
     // Execute query and return if error occurs
     if(!packCheckQuery.exec())
@@ -790,6 +1749,7 @@ DbError Db::entryUsesDataPack(bool& resultBuffer, const QUuid& gameId)
     // Set buffer based on result
     packCheckQuery.next();
     resultBuffer = packCheckQuery.value(0).toInt() > 0;
+    recycleStatement(packCheckQuery, *fpDb);
 
     // Return invalid error
     return DbError();
@@ -797,67 +1757,77 @@ DbError Db::entryUsesDataPack(bool& resultBuffer, const QUuid& gameId)
 
 DbError Db::getEntry(Entry& entry, const QUuid& entryId)
 {
-    // Find title
-    Db::EntryFilter mainFilter{.type = Fp::Db::EntryType::PrimaryThenAddApp, .id = entryId};
+    // Like getGameData(), the ID is matched as is; use handleGameRedirects() first to follow a redirect
+    // Check cache
+    checkItemCacheCoherency();
+    if(mItemCache->find(entryId, entry))
+        return DbError();
+    quint64 cacheGeneration = mItemCache->generation();
 
+    // Find title as either type at once, two results are enough to detect a collision
     Fp::Db::QueryBuffer searchResult;
-    DbError searchError = queryEntrys(searchResult, mainFilter);
+    DbError searchError = queryEntriesById(searchResult, {entryId}, false, 2);
     if(searchError.isValid())
         return searchError;
 
-    // Check if ID was found and that only one instance was found
-    if(searchResult.size == 0)
+    // Check if ID was found
+    if(searchResult.isEmpty())
+    {
+        recycleStatement(searchResult);
         return DbError(DbError::IncompleteSearch, ERR_ID_NOT_FOUND);
-    else if(searchResult.size > 1)
+    }
+
+    // Advance result to first record and fill variant
+    searchResult.next();
+    int firstPriority = searchResult.value(0).toInt();
+    Entry foundEntry = buildPolymorphicEntry(searchResult);
+
+    // Ensure that only one instance was found (games take precedence over add apps, as before)
+    bool collision = searchResult.next() && searchResult.value(0).toInt() == firstPriority;
+    recycleStatement(searchResult);
+    if(collision)
         return DbError(DbError::IdCollision, ERR_ID_DUPLICATE_ENTRY);
 
-    // Advance result to only record
-    searchResult.result.next();
-
-    // Fill variant
-    if(searchResult.source == Db::Table_Add_App::NAME)
-    {
-        AddApp::Builder fpAab;
-        fpAab.wId(searchResult.result.value(Fp::Db::Table_Add_App::COL_ID).toString());
-        fpAab.wAppPath(searchResult.result.value(Fp::Db::Table_Add_App::COL_APP_PATH).toString());
-        fpAab.wAutorunBefore(searchResult.result.value(Fp::Db::Table_Add_App::COL_AUTORUN).toString());
-        fpAab.wLaunchCommand(searchResult.result.value(Fp::Db::Table_Add_App::COL_LAUNCH_COMMAND).toString());
-        fpAab.wName(searchResult.result.value(Fp::Db::Table_Add_App::COL_NAME).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpAab.wWaitExit(searchResult.result.value(Fp::Db::Table_Add_App::COL_WAIT_EXIT).toString());
-        fpAab.wParentId(searchResult.result.value(Fp::Db::Table_Add_App::COL_PARENT_ID).toString());
-
-        entry = fpAab.build();
-    }
-    else if(searchResult.source == Db::Table_Game::NAME)
-    {
-        Game::Builder fpGb;
-        fpGb.wId(searchResult.result.value(Fp::Db::Table_Game::COL_ID).toString());
-        fpGb.wTitle(searchResult.result.value(Fp::Db::Table_Game::COL_TITLE).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpGb.wSeries(searchResult.result.value(Fp::Db::Table_Game::COL_SERIES).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpGb.wDeveloper(searchResult.result.value(Fp::Db::Table_Game::COL_DEVELOPER).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpGb.wPublisher(searchResult.result.value(Fp::Db::Table_Game::COL_PUBLISHER).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpGb.wDateAdded(searchResult.result.value(Fp::Db::Table_Game::COL_DATE_ADDED).toString());
-        fpGb.wDateModified(searchResult.result.value(Fp::Db::Table_Game::COL_DATE_MODIFIED).toString());
-        fpGb.wBroken(searchResult.result.value(Fp::Db::Table_Game::COL_BROKEN).toString());
-        fpGb.wPlayMode(searchResult.result.value(Fp::Db::Table_Game::COL_PLAY_MODE).toString());
-        fpGb.wStatus(searchResult.result.value(Fp::Db::Table_Game::COL_STATUS).toString());
-        fpGb.wNotes(searchResult.result.value(Fp::Db::Table_Game::COL_NOTES).toString());
-        fpGb.wSource(searchResult.result.value(Fp::Db::Table_Game::COL_SOURCE).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpGb.wAppPath(searchResult.result.value(Fp::Db::Table_Game::COL_APP_PATH).toString());
-        fpGb.wLaunchCommand(searchResult.result.value(Fp::Db::Table_Game::COL_LAUNCH_COMMAND).toString());
-        fpGb.wReleaseDate(searchResult.result.value(Fp::Db::Table_Game::COL_RELEASE_DATE).toString());
-        fpGb.wVersion(searchResult.result.value(Fp::Db::Table_Game::COL_VERSION).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpGb.wOriginalDescription(searchResult.result.value(Fp::Db::Table_Game::COL_ORIGINAL_DESC).toString());
-        fpGb.wLanguage(searchResult.result.value(Fp::Db::Table_Game::COL_LANGUAGE).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpGb.wOrderTitle(searchResult.result.value(Fp::Db::Table_Game::COL_ORDER_TITLE).toString().remove(Qx::RegularExpression::LINE_BREAKS));
-        fpGb.wLibrary(searchResult.result.value(Fp::Db::Table_Game::COL_LIBRARY).toString());
-        fpGb.wPlatformName(searchResult.result.value(Fp::Db::Table_Game::COL_PLATFORM_NAME).toString());
-        fpGb.wRuffleSupport(searchResult.result.value(Fp::Db::Table_Game::COL_RUFFLE_SUPPORT).toString());
-
-        entry = fpGb.build();
+    entry = std::move(foundEntry);
+    mItemCache->insert(entryId, entry, cacheGeneration);
+    return DbError();
+}
+
+DbError Db::getEntries(QHash<QUuid, Entry>& entries, const QList<QUuid>& entryIds)
+{
+    // Clear buffer
+    entries.clear();
+    if(entryIds.isEmpty())
+        return DbError();
+
+    // Find titles as either type at once, redirects are applied by the query
+    Fp::Db::QueryBuffer searchResult;
+    DbError searchError = queryEntriesById(searchResult, entryIds, true);
+    if(searchError.isValid())
+        return searchError;
+
+    static const int requestedColumn = 1 + Table_Game::ORD_COUNT + Table_Add_App::ORD_COUNT; // See queryEntriesById() for layout
+    QHash<QUuid, int> foundPriorities;
+    while(searchResult.next())
+    {
+        int priority = searchResult.value(0).toInt();
+        QUuid requestedId(searchResult.value(requestedColumn).toString());
+
+        // Games come first and take precedence over add apps, but duplicates within one table are a problem
+        if(auto fItr = foundPriorities.constFind(requestedId); fItr != foundPriorities.cend())
+        {
+            if(*fItr == priority)
+            {
+                recycleStatement(searchResult);
+                return DbError(DbError::IdCollision, ERR_ID_DUPLICATE_ENTRY, requestedId.toString(QUuid::WithoutBraces));
+            }
+            continue;
+        }
+        foundPriorities.insert(requestedId, priority);
+
+        entries.insert(requestedId, buildPolymorphicEntry(searchResult));
     }
-    else
-        qFatal("Entry search result source must be 'game' or 'additional_app'");
+    recycleStatement(searchResult);
 
     return DbError();
 }
@@ -867,6 +1837,12 @@ DbError Db::getGameData(GameData& data, const QUuid& gameId)
     // Clear buffer
     data = GameData();
 
+    // Check cache
+    checkItemCacheCoherency();
+    if(mItemCache->find(gameId, data))
+        return DbError();
+    quint64 cacheGeneration = mItemCache->generation();
+
     // Get entry data
     DbError searchError;
     Fp::Db::QueryBuffer searchResult;
@@ -874,47 +1850,92 @@ DbError Db::getGameData(GameData& data, const QUuid& gameId)
     if((searchError = queryEntryDataById(searchResult, gameId)).isValid())
         return searchError;
 
-    // Check if ID was found and if so that only one instance was found
-    if(searchResult.size == 0)
+    // Check if ID was found
+    if(searchResult.isEmpty())
+    {
+        recycleStatement(searchResult);
+        mItemCache->insert(gameId, data, cacheGeneration);
         return DbError(); // Game doesn't have data pack
-    else if(searchResult.size > 1)
+    }
+
+    // Advance result to first record and fill buffer
+    searchResult.next();
+    data = buildGameData(searchResult);
+
+    // Check that only one instance was found
+    if(searchResult.next())
         qWarning("Entry %s has more than one data pack, using most recent.", qPrintable(gameId.toString(QUuid::WithoutBraces)));
+    recycleStatement(searchResult);
+    mItemCache->insert(gameId, data, cacheGeneration);
 
-    // Advance result to first record
-    searchResult.result.next();
+    return DbError();
+}
 
-    // Fill buffer
-    GameData::Builder fpGdb;
-    fpGdb.wId(searchResult.result.value(Fp::Db::Table_Game_Data::COL_ID).toString());
-    fpGdb.wGameId(searchResult.result.value(Fp::Db::Table_Game_Data::COL_GAME_ID).toString());
-    fpGdb.wTitle(searchResult.result.value(Fp::Db::Table_Game_Data::COL_TITLE).toString());
-    fpGdb.wDateAdded(searchResult.result.value(Fp::Db::Table_Game_Data::COL_DATE_ADDED).toString());
-    fpGdb.wSha256(searchResult.result.value(Fp::Db::Table_Game_Data::COL_SHA256).toString());
-    fpGdb.wCrc32(searchResult.result.value(Fp::Db::Table_Game_Data::COL_CRC32).toString());
-    fpGdb.wPresentOnDisk(searchResult.result.value(Fp::Db::Table_Game_Data::COL_PRES_ON_DISK).toString());
-    fpGdb.wPath(searchResult.result.value(Fp::Db::Table_Game_Data::COL_PATH).toString());
-    fpGdb.wSize(searchResult.result.value(Fp::Db::Table_Game_Data::COL_SIZE).toString());
-    fpGdb.wRawParameters(searchResult.result.value(Fp::Db::Table_Game_Data::COL_PARAM).toString());
-    fpGdb.wAppPath(searchResult.result.value(Fp::Db::Table_Game_Data::COL_APP_PATH).toString());
-    fpGdb.wLaunchCommand(searchResult.result.value(Fp::Db::Table_Game_Data::COL_LAUNCH_COMMAND).toString());
-
-    data = fpGdb.build();
+DbError Db::getGameDataBatch(QHash<QUuid, GameData>& data, const QList<QUuid>& gameIds)
+{
+    // Clear buffer
+    data.clear();
+    if(gameIds.isEmpty())
+        return DbError();
+
+    // Get database
+    std::shared_ptr<PooledConnection> fpDb;
+    if(QSqlError dbError = getConnection(fpDb); dbError.isValid())
+        return DbError::fromSqlError(dbError);
+
+    // Get entry data with redirects applied, most recent first for each game. The requested ID trails the data columns
+    QString baseQueryCommand = redirectCte(u":gameIds"_s) + u"SELECT %1 FROM "_s + Table_Game_Data::NAME + u" JOIN "_s + REDIRECT_TARGET +
+                               u" ON "_s + Table_Game_Data::COL_GAME_ID + u" = "_s + REDIRECT_TARGET + u".targetId"_s +
+                               u" ORDER BY "_s + REDIRECT_TARGET + u".requestedId, "_s + Table_Game_Data::COL_DATE_ADDED + u" DESC"_s;
+    QString mainQueryCommand = baseQueryCommand.arg(u"`"_s + Table_Game_Data::COLUMN_LIST.join(u"`,`"_s) + u"`,"_s + REDIRECT_TARGET + u".requestedId"_s);
+    QString sizeQueryCommand = baseQueryCommand.arg(GENERAL_QUERY_SIZE_COMMAND);
+
+    Fp::Db::QueryBuffer searchResult;
+    if(QSqlError queryError = makeQuery(searchResult, fpDb, Table_Game_Data::NAME, mainQueryCommand, sizeQueryCommand,
+                                        {{u":gameIds"_s, idSetJson(gameIds)}}); queryError.isValid())
+        return DbError::fromSqlError(queryError);
+
+    while(searchResult.next())
+    {
+        QUuid requestedId(searchResult.value(Table_Game_Data::ORD_COUNT).toString());
+        if(data.contains(requestedId))
+        {
+            qWarning("Entry %s has more than one data pack, using most recent.", qPrintable(requestedId.toString(QUuid::WithoutBraces)));
+            continue;
+        }
+
+        data.insert(requestedId, buildGameData(searchResult));
+    }
+    recycleStatement(searchResult);
 
     return DbError();
 }
 
 DbError Db::getGameTags(GameTags& tags, const QUuid& gameId)
 {
+    // Check cache
+    checkItemCacheCoherency();
+    if(mItemCache->find(gameId, tags))
+        return DbError();
+    quint64 cacheGeneration = mItemCache->generation();
+
+    // Get metadata before a connection, a pending load shouldn't be waited on while holding one
+    std::shared_ptr<const Metadata> md;
+    if(DbError metadataError = metadata(md); metadataError.isValid())
+        return metadataError;
+
     // Get database
-    QSqlDatabase fpDb;
-    if(QSqlError dbError = getThreadConnection(fpDb); dbError.isValid())
+    std::shared_ptr<PooledConnection> fpDb;
+    if(QSqlError dbError = getConnection(fpDb); dbError.isValid())
         return DbError::fromSqlError(dbError);
 
     // Query tags
-    QSqlQuery tagQuery(fpDb);
-    tagQuery.setForwardOnly(true);
-    tagQuery.prepare(u"SELECT `"_s + Table_Game_Tags_Tag::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Game_Tags_Tag::NAME + u" WHERE "_s +
-                     Table_Game_Tags_Tag::COL_GAME_ID + u" == '"_s + gameId.toString(QUuid::WithoutBraces) + u"' "_s);
+    QSqlQuery tagQuery;
+    QString tagQueryCommand = u"SELECT `"_s + Table_Game_Tags_Tag::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Game_Tags_Tag::NAME + u" WHERE "_s +
+                              Table_Game_Tags_Tag::COL_GAME_ID + u" == :gameId"_s;
+    if(QSqlError prepError = prepareStatement(tagQuery, *fpDb, tagQueryCommand); prepError.isValid())
+        return DbError::fromSqlError(prepError);
+    tagQuery.bindValue(u":gameId"_s, gameId.toString(QUuid::WithoutBraces));
     if(!tagQuery.exec())
         return DbError::fromSqlError(tagQuery.lastError());
 
@@ -922,72 +1943,447 @@ DbError Db::getGameTags(GameTags& tags, const QUuid& gameId)
     GameTags::Builder gtb;
     while(tagQuery.next())
     {
-        int tagId = tagQuery.value(Table_Game_Tags_Tag::COL_TAG_ID).toInt();
-        auto tagItr = mTagMap.constFind(tagId);
-        if(tagItr != mTagMap.constEnd())
-        {
-            auto tag = *tagItr;
+        int tagId = tagQuery.value(Table_Game_Tags_Tag::ORD_TAG_ID).toInt();
+        if(const Tag* tag = md->tagDirectory->findTag(tagId))
             gtb.wTag(tag->category, tag->primaryAlias);
-        }
         else
             qWarning("Table %s contains invalid tag ID %d for game %s", qPrintable(Table_Game_Tags_Tag::NAME), tagId, qPrintable(gameId.toString()));
     }
     tags = gtb.build();
+    recycleStatement(tagQuery, *fpDb);
+    mItemCache->insert(gameId, tags, cacheGeneration);
+
+    return DbError();
+}
+
+DbError Db::getGameTagsBatch(QHash<QUuid, GameTags>& tags, const QList<QUuid>& gameIds)
+{
+    // Clear buffer
+    tags.clear();
+    if(gameIds.isEmpty())
+        return DbError();
+
+    // Collect tags of all games at once, redirects are handled by the stream
+    QHash<QUuid, GameTags::Builder> builders;
+    DbError tagError = forEachEntryTag([&builders](const QUuid& gameId, const Tag& tag){
+        builders[gameId].wTag(tag.category, tag.primaryAlias);
+        return true;
+    }, &gameIds);
+    if(tagError.isValid())
+        return tagError;
+
+    for(auto [gameId, builder] : builders.asKeyValueRange())
+        tags.insert(gameId, builder.build());
 
     return DbError();
 }
 
-DbError Db::updateGameDataOnDiskState(QList<int> packIds, bool onDisk)
+DbError Db::forEachEntryTag(const std::function<bool(const QUuid&, const Tag&)>& visitor, std::optional<const QList<QUuid>*> gameIdFilter)
+{
+    if(gameIdFilter && gameIdFilter.value()->isEmpty())
+        return DbError();
+
+    // Get metadata before a connection, a pending load shouldn't be waited on while holding one. Also keeps the tags handed to the visitor alive
+    std::shared_ptr<const Metadata> md;
+    if(DbError metadataError = metadata(md); metadataError.isValid())
+        return metadataError;
+
+    // Get database
+    std::shared_ptr<PooledConnection> fpDb;
+    if(QSqlError dbError = getConnection(fpDb); dbError.isValid())
+        return DbError::fromSqlError(dbError);
+
+    // Query all pairs in one pass. When filtered, redirects are applied and results are reported under the ID that was requested
+    QSqlQuery tagQuery;
+    QString tagQueryCommand = u"SELECT `"_s + Table_Game_Tags_Tag::COLUMN_LIST.join(u"`,`"_s) + u"`"_s;
+    if(gameIdFilter)
+    {
+        tagQueryCommand = redirectCte(u":gameIds"_s) + tagQueryCommand + u","_s + REDIRECT_TARGET + u".requestedId FROM "_s + Table_Game_Tags_Tag::NAME +
+                          u" JOIN "_s + REDIRECT_TARGET + u" ON "_s + Table_Game_Tags_Tag::COL_GAME_ID + u" = "_s + REDIRECT_TARGET + u".targetId"_s +
+                          u" ORDER BY "_s + REDIRECT_TARGET + u".requestedId"_s;
+    }
+    else
+        tagQueryCommand += u" FROM "_s + Table_Game_Tags_Tag::NAME + u" ORDER BY "_s + Table_Game_Tags_Tag::COL_GAME_ID;
+
+    if(QSqlError prepError = prepareStatement(tagQuery, *fpDb, tagQueryCommand); prepError.isValid())
+        return DbError::fromSqlError(prepError);
+    if(gameIdFilter)
+        tagQuery.bindValue(u":gameIds"_s, idSetJson(*gameIdFilter.value()));
+    if(!tagQuery.exec())
+        return DbError::fromSqlError(tagQuery.lastError());
+
+    // Parse query, rows of the same game are adjacent so each ID is only parsed once
+    const int reportColumn = gameIdFilter ? Table_Game_Tags_Tag::ORD_COUNT : Table_Game_Tags_Tag::ORD_GAME_ID;
+    QString rawReportId;
+    QUuid reportId;
+    while(tagQuery.next())
+    {
+        QString rawRowId = tagQuery.value(reportColumn).toString();
+        if(rawRowId != rawReportId)
+        {
+            rawReportId = rawRowId;
+            reportId = QUuid(rawReportId);
+        }
+
+        int tagId = tagQuery.value(Table_Game_Tags_Tag::ORD_TAG_ID).toInt();
+        const Tag* tag = md->tagDirectory->findTag(tagId);
+        if(!tag)
+        {
+            qWarning("Table %s contains invalid tag ID %d for game %s", qPrintable(Table_Game_Tags_Tag::NAME), tagId,
+                     qPrintable(tagQuery.value(Table_Game_Tags_Tag::ORD_GAME_ID).toString()));
+            continue;
+        }
+
+        if(!visitor(reportId, *tag))
+            break;
+    }
+
+    DbError parseError = DbError::fromSqlError(tagQuery.lastError());
+    recycleStatement(tagQuery, *fpDb);
+
+    return parseError;
+}
+
+DbError Db::updateGameDataOnDiskState(const QList<int>& packIds, bool onDisk, const BulkProgressHandler& progress, int chunkSize)
 {
+    // Writing behind the back of immutable connections would leave them with stale pages
+    if(mProfile.immutable)
+        return DbError(DbError::WriteDenied, ERR_IMMUTABLE_WRITE);
+
+    // Duplicates would throw off the affected row count
+    QList<int> ids = packIds;
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    if(ids.isEmpty())
+        return DbError();
+    chunkSize = std::max(chunkSize, 1);
+
     // Get database
-    QSqlDatabase fpDb;
-    QSqlError dbError = getThreadConnection(fpDb);
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getWriteConnection(fpDb);
     if(dbError.isValid())
         return DbError::fromSqlError(dbError);
+    QMutexLocker writeLocker(&mWriteMutex);
 
-    // Make query
-    QString filter = Qx::String::join(packIds, [](int i){ return QString::number(i); }, u","_s);
-    QString dataUpdateCommand = u"UPDATE "_s + Table_Game_Data::NAME + u" SET "_s + Table_Game_Data::COL_PRES_ON_DISK + u" = "_s + QString::number(onDisk) +
-                                u" WHERE "_s + Table_Game_Data::COL_ID + u" IN ("_s + filter + ')';
+    // Make query, each chunk is bound as one JSON array so the statement is the same for all of them
+    QString dataUpdateCommand = u"UPDATE "_s + Table_Game_Data::NAME + u" SET "_s + Table_Game_Data::COL_PRES_ON_DISK + u" = :onDisk WHERE "_s +
+                                idSetFilter(Table_Game_Data::COL_ID, u":packIds"_s);
 
-    QSqlQuery packUpdateQuery(fpDb);
+    QSqlQuery packUpdateQuery(fpDb->database);
     packUpdateQuery.setForwardOnly(true);
-    packUpdateQuery.prepare(dataUpdateCommand);
-
-    // Execute query and return if error occurs
-    if(!packUpdateQuery.exec())
+    if(!packUpdateQuery.prepare(dataUpdateCommand))
         return DbError::fromSqlError(packUpdateQuery.lastError());
 
-    // Check that expected count was affected
-    int expected = packIds.size();
-    int affected = packUpdateQuery.numRowsAffected();
-    if(affected != expected)
-        return DbError(DbError::UpdateRowMismatch, Table_Game_Data::NAME + u" SET "_s + Table_Game_Data::COL_PRES_ON_DISK, u"%1 instead of %2"_s.arg(affected, expected));
+    // All chunks land together or not at all, the write lock is taken up front so that none fail partway for being busy
+    QSqlQuery transactionQuery(fpDb->database);
+    if(!transactionQuery.exec(u"BEGIN IMMEDIATE"_s))
+        return DbError::fromSqlError(transactionQuery.lastError());
+    QScopeGuard rollbackGuard([&transactionQuery](){ transactionQuery.exec(u"ROLLBACK"_s); });
+
+    // Update in chunks
+    BulkProgress report{
+        .chunk = 0,
+        .chunkCount = (ids.size() + chunkSize - 1) / chunkSize,
+        .processed = 0,
+        .total = ids.size(),
+        .expected = 0,
+        .affected = 0
+    };
+    qsizetype totalAffected = 0;
+
+    for(qsizetype start = 0; start < ids.size(); start += chunkSize)
+    {
+        QList<int> chunk = ids.mid(start, chunkSize);
+        packUpdateQuery.bindValue(u":onDisk"_s, int(onDisk));
+        packUpdateQuery.bindValue(u":packIds"_s, u"["_s + Qx::String::join(chunk, [](int i){ return QString::number(i); }, u","_s) + u"]"_s);
+        if(!packUpdateQuery.exec())
+            return DbError::fromSqlError(packUpdateQuery.lastError());
+
+        report.chunk++;
+        report.processed += chunk.size();
+        report.expected = chunk.size();
+        report.affected = packUpdateQuery.numRowsAffected();
+        totalAffected += report.affected;
+        if(progress)
+            progress(report);
+    }
+    packUpdateQuery.finish();
+
+    if(!transactionQuery.exec(u"COMMIT"_s))
+        return DbError::fromSqlError(transactionQuery.lastError());
+    rollbackGuard.dismiss();
+    mItemCache->removeGameData(ids);
+
+    // Check that expected count was affected, missing packs don't undo the rest
+    if(totalAffected != ids.size())
+        return DbError(DbError::UpdateRowMismatch, Table_Game_Data::NAME + u" SET "_s + Table_Game_Data::COL_PRES_ON_DISK,
+                       u"%1 instead of %2"_s.arg(totalAffected).arg(ids.size()));
 
     return DbError();
 }
 
-/* TODO: Technically this is a shortcut. The regular launcher will check for Game Redirects in all cases where an ID is searched
- * for, often using coalesce (see https://github.com/FlashpointProject/FPA-Rust/blob/03a4ddc4af9ae0b2773c5f678268cb9c944d893f/crates/flashpoint-archive/src/game/mod.rs#L323).
- * This makes sense if anyone is using this lib for any reason (which although that is the intention, currently no one is); but in the case of CLIFp/FIL, where
- * IDs are only sought out directly, or in bulk, we can just swap the target ID (if a direct is present) before even hitting the database with it.
- * Just keep in mind the ideal long term thing to do is have the redirects considered whenever checking the database for a game ID at all. This could
- * also be an issue if a source ID is still used somewhere else in the DB, for example add_app or game_data, but that does not seem to be the case currently.
+/* Bulk lookups (getEntries(), getGameDataBatch(), getGameTagsBatch() and the ID inclusion filter of queryGamesByPlatform()) resolve
+ * redirects within the query (see redirectCte()), like the regular launcher does
+ * (see https://github.com/FlashpointProject/FPA-Rust/blob/03a4ddc4af9ae0b2773c5f678268cb9c944d893f/crates/flashpoint-archive/src/game/mod.rs#L323).
+ * This swaps a single ID ahead of time for the remaining direct lookups (getEntry(), getGameData()). Chains are already collapsed in memory,
+ * so this is one lookup. In both cases an ID that is still a game is never redirected.
+ * Keep in mind this could be an issue if a source ID is still used somewhere else in the DB, for example add_app or game_data, but that does
+ * not seem to be the case currently.
  */
-QUuid Db::handleGameRedirects(const QUuid& gameId) { return mGameRedirects.value(gameId, gameId); }
+QUuid Db::handleGameRedirects(const QUuid& gameId) { return metadata()->gameRedirects.value(gameId, gameId); }
 
-//-Slots ------------------------------------------------------------------------------------------------------
-//Private:
-void Db::connectedThreadDestroyed(QObject* thread)
+DbError Db::waitForMetadata()
+{
+    QMutexLocker metadataLocker(&mMetadataMutex);
+    finishMetadataLoad();
+    return mMetadataError;
+}
+
+DbError Db::refreshMetadata(bool force)
+{
+    // One refresh at a time, readers keep using the current version throughout
+    QMutexLocker refreshLocker(&mRefreshMutex);
+
+    // Skip if nothing was committed since the current version was read, or if that can't be known for an immutable database
+    std::optional<quint64> generation = dataGeneration();
+    if(!force && (mProfile.immutable || (generation && generation == mMetadataGeneration)))
+        return DbError();
+
+    // A pending initial load would otherwise land on top of the refresh
+    {
+        QMutexLocker metadataLocker(&mMetadataMutex);
+        finishMetadataLoad();
+    }
+
+    std::optional<MetadataCache::Stamp> cacheStamp = mMetadataCache ? mMetadataCache->stamp() : std::nullopt;
+    std::shared_ptr<const Metadata> current = metadata();
+    std::shared_ptr<const Metadata> fresh;
+    if(QSqlError populateError = populateMetadata(fresh, current.get()); populateError.isValid())
+        return DbError::fromSqlError(populateError);
+
+    // The cache vouches for the schema, which may have changed along with the data
+    if(cacheStamp && !validateSchema().isValid())
+        mMetadataCache->save(*fresh, *cacheStamp);
+
+    {
+        QMutexLocker metadataLocker(&mMetadataMutex);
+        mMetadata = std::move(fresh);
+        mMetadataError = DbError();
+    }
+    mMetadataGeneration = generation;
+
+    // Derived data is rebuilt on next use
+    {
+        QMutexLocker indexLocker(&mTagIndexMutex);
+        mTagIndex.reset();
+    }
+    mItemCache->clear();
+
+    emit metadataChanged();
+    return DbError();
+}
+
+void Db::setAutoRefresh(bool enabled)
+{
+    // An immutable database is promised to never change
+    if(enabled && !mProfile.immutable)
+        watchFiles();
+    else if(!mFileWatcher.files().isEmpty() || !mFileWatcher.directories().isEmpty())
+    {
+        mFileWatcher.removePaths(mFileWatcher.files() + mFileWatcher.directories());
+        mRefreshTimer.stop();
+    }
+}
+
+void Db::setItemCacheCapacity(qsizetype bytes) { mItemCache->setCapacity(bytes); }
+void Db::clearItemCache() { mItemCache->clear(); }
+
+void Db::setSearchIndexPath(const QString& path)
+{
+    QMutexLocker searchLocker(&mSearchIndexMutex);
+    if(path == mSearchIndexPath)
+        return;
+
+    // The index is reopened with the new path on next use
+    mSearchIndexPath = path;
+    mSearchIndex.reset();
+}
+
+DbError Db::updateSearchIndex() { return DbError::fromSqlError(searchIndex()->update()); }
+
+bool Db::hasNativeBackend()
+{
+#ifdef FP_NATIVE_SQLITE
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef FP_NATIVE_SQLITE
+DbError Db::forEachGame(const std::function<bool(const GameView&)>& visitor, const LibraryFilter& filter)
+{
+    QString command = u"SELECT `"_s + Table_Game::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Game::NAME;
+    if(filter == LibraryFilter::Game)
+        command += u" WHERE "_s + GAME_ONLY_FILTER;
+    else if(filter == LibraryFilter::Anim)
+        command += u" WHERE "_s + ANIM_ONLY_FILTER;
+
+    return forEachRow(command, visitor);
+}
+
+DbError Db::forEachAddApp(const std::function<bool(const AddAppView&)>& visitor)
+{
+    return forEachRow(u"SELECT `"_s + Table_Add_App::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Add_App::NAME, visitor);
+}
+
+DbError Db::forEachGameData(const std::function<bool(const GameDataView&)>& visitor)
+{
+    return forEachRow(u"SELECT `"_s + Table_Game_Data::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Table_Game_Data::NAME, visitor);
+}
+#endif
+
+DbError Db::snapshot(std::shared_ptr<const Snapshot>& resultBuffer)
+{
+    // Ensure return buffer is reset
+    resultBuffer.reset();
+
+    // Get database
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
+    if(dbError.isValid())
+        return DbError::fromSqlError(dbError);
+
+    // Load, it only becomes visible once complete and can't be changed afterwards
+    std::shared_ptr<Snapshot> snapshot(new Snapshot());
+    if(QSqlError loadError = snapshot->load(fpDb->database); loadError.isValid())
+        return DbError::fromSqlError(loadError);
+
+    resultBuffer = std::move(snapshot);
+    return DbError();
+}
+
+DbError Db::gameRecords(std::shared_ptr<const GameRecordSet>& resultBuffer, const LibraryFilter& filter, bool includeLongText)
+{
+    // Ensure return buffer is reset
+    resultBuffer.reset();
+
+    // Long text is the bulk of most rows, so when it isn't wanted have SQLite skip it entirely
+    QStringList columns;
+    for(const QString& column : Table_Game::COLUMN_LIST)
+    {
+        bool longText = column == Table_Game::COL_NOTES || column == Table_Game::COL_ORIGINAL_DESC;
+        columns.append(!includeLongText && longText ? u"''"_s : u"`"_s + column + u"`"_s);
+    }
+
+    QString command = u"SELECT "_s + columns.join(u","_s) + u" FROM "_s + Table_Game::NAME;
+    if(filter == LibraryFilter::Game)
+        command += u" WHERE "_s + GAME_ONLY_FILTER;
+    else if(filter == LibraryFilter::Anim)
+        command += u" WHERE "_s + ANIM_ONLY_FILTER;
+
+    // Get database
+    std::shared_ptr<PooledConnection> fpDb;
+    QSqlError dbError = getConnection(fpDb);
+    if(dbError.isValid())
+        return DbError::fromSqlError(dbError);
+
+    QSqlQuery gameQuery(fpDb->database);
+    gameQuery.setForwardOnly(true);
+    if(!gameQuery.exec(command))
+        return DbError::fromSqlError(gameQuery.lastError());
+
+    QueryBuffer gameBuffer;
+    gameBuffer.setResult(fpDb, Table_Game::NAME, std::move(gameQuery), QString());
+
+    // Pack each game as it's read so that only one full Game exists at a time
+    std::shared_ptr<GameRecordSet> records(new GameRecordSet(includeLongText));
+    QHash<QString, GameRecord::StringId> interned;
+    while(gameBuffer.next())
+        records->append(buildGame(gameBuffer), interned);
+
+    if(QSqlError readError = gameBuffer.mResult.lastError(); readError.isValid())
+        return DbError::fromSqlError(readError);
+
+    records->seal();
+    resultBuffer = std::move(records);
+    return DbError();
+}
+
+QFuture<Db::AsyncResult<QList<Game>>> Db::queryGamesByPlatformAsync(const QStringList& platforms, const InclusionOptions& inclusionOptions,
+                                                                    const std::optional<QList<QUuid>>& idInclusionFilter)
+{
+    return runAsync<QList<Game>>([=, this](QList<Game>& resultBuffer){
+        std::optional<const QList<QUuid>*> idFilter;
+        if(idInclusionFilter)
+            idFilter = &idInclusionFilter.value();
+
+        // Read through in full here, the cursor can't leave this thread
+        QueryBuffer gameBuffer;
+        if(DbError queryError = queryGamesByPlatform(gameBuffer, platforms, inclusionOptions, idFilter); queryError.isValid())
+            return queryError;
+
+        while(gameBuffer.next())
+            resultBuffer.append(buildGame(gameBuffer));
+
+        DbError readError = DbError::fromSqlError(gameBuffer.mResult.lastError());
+        recycleStatement(gameBuffer);
+        return readError;
+    });
+}
+
+QFuture<Db::AsyncResult<QList<Entry>>> Db::queryEntrysAsync(const EntryFilter& filter)
+{
+    return runAsync<QList<Entry>>([=, this](QList<Entry>& resultBuffer){
+        // Read through in full here, the cursor can't leave this thread
+        QueryBuffer entryBuffer;
+        if(DbError queryError = queryEntrys(entryBuffer, filter); queryError.isValid())
+            return queryError;
+
+        bool addApps = entryBuffer.source() == Table_Add_App::NAME;
+        while(entryBuffer.next())
+            resultBuffer.append(addApps ? Entry(buildAddApp(entryBuffer)) : Entry(buildGame(entryBuffer)));
+
+        DbError readError = DbError::fromSqlError(entryBuffer.mResult.lastError());
+        recycleStatement(entryBuffer);
+        return readError;
+    });
+}
+
+QFuture<Db::AsyncResult<QList<QUuid>>> Db::searchEntrysAsync(const QString& text, int limit)
+{
+    return runAsync<QList<QUuid>>([=, this](QList<QUuid>& resultBuffer){ return searchEntrys(resultBuffer, text, limit); });
+}
+
+QFuture<Db::AsyncResult<Entry>> Db::getEntryAsync(const QUuid& entryId)
+{
+    return runAsync<Entry>([=, this](Entry& entry){ return getEntry(entry, entryId); });
+}
+
+QFuture<Db::AsyncResult<QHash<QUuid, Entry>>> Db::getEntriesAsync(const QList<QUuid>& entryIds)
 {
-    QThread* pThread = qobject_cast<QThread*>(thread);
+    return runAsync<QHash<QUuid, Entry>>([=, this](QHash<QUuid, Entry>& entries){ return getEntries(entries, entryIds); });
+}
+
+QFuture<Db::AsyncResult<GameData>> Db::getGameDataAsync(const QUuid& gameId)
+{
+    return runAsync<GameData>([=, this](GameData& data){ return getGameData(data, gameId); });
+}
 
-    // Ensure the signal that triggered this slot belongs to the above class by checking for null pointer
-    if(pThread == nullptr)
-        qFatal("Pointer conversion to thread failed");
+QFuture<Db::AsyncResult<GameTags>> Db::getGameTagsAsync(const QUuid& gameId)
+{
+    return runAsync<GameTags>([=, this](GameTags& tags){ return getGameTags(tags, gameId); });
+}
+
+//-Signals & Slots------------------------------------------------------------------------------------------------------------
+//Private Slots:
+void Db::fileChangeHandler(const QString& path)
+{
+    Q_UNUSED(path);
 
-    // Close connection
-    closeConnection(pThread);
+    // Re-arm the watch in case the file was replaced or the WAL appeared, then check once things settle
+    watchFiles();
+    mRefreshTimer.start();
 }
 
 }
@@ -0,0 +1,139 @@
+// Unit Includes
+#include "fp/fp-dbview.h"
+
+// SQLite Includes
+#include <sqlite3.h>
+
+namespace Fp
+{
+
+namespace
+{
+    sqlite3_stmt* statement(const void* row) { return static_cast<sqlite3_stmt*>(const_cast<void*>(row)); }
+}
+
+//===============================================================================================================
+// RowView
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Protected:
+RowView::RowView(const void* row) :
+    mRow(row)
+{}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+bool RowView::isNull(int column) const { return sqlite3_column_type(statement(mRow), column) == SQLITE_NULL; }
+
+QUtf8StringView RowView::text(int column) const
+{
+    // Text must be fetched before its size, as fetching it may convert the value
+    auto text = reinterpret_cast<const char*>(sqlite3_column_text(statement(mRow), column));
+    return QUtf8StringView(text, sqlite3_column_bytes(statement(mRow), column));
+}
+
+qint64 RowView::integer(int column) const { return sqlite3_column_int64(statement(mRow), column); }
+
+//===============================================================================================================
+// GameView
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Private:
+GameView::GameView(const void* row) : RowView(row) {}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+Game GameView::toGame() const
+{
+    using T = Db::Table_Game;
+    auto s = [&](T::Ordinal column){ return text(column).toString(); };
+
+    Game::Builder fpGb;
+    fpGb.wId(s(T::ORD_ID));
+    fpGb.wTitle(Db::singleLine(s(T::ORD_TITLE)));
+    fpGb.wSeries(Db::singleLine(s(T::ORD_SERIES)));
+    fpGb.wDeveloper(Db::singleLine(s(T::ORD_DEVELOPER)));
+    fpGb.wPublisher(Db::singleLine(s(T::ORD_PUBLISHER)));
+    fpGb.wDateAdded(s(T::ORD_DATE_ADDED));
+    fpGb.wDateModified(s(T::ORD_DATE_MODIFIED));
+    fpGb.wBroken(integer(T::ORD_BROKEN) != 0);
+    fpGb.wPlayMode(s(T::ORD_PLAY_MODE));
+    fpGb.wStatus(s(T::ORD_STATUS));
+    fpGb.wNotes(s(T::ORD_NOTES));
+    fpGb.wSource(Db::singleLine(s(T::ORD_SOURCE)));
+    fpGb.wAppPath(s(T::ORD_APP_PATH));
+    fpGb.wLaunchCommand(s(T::ORD_LAUNCH_COMMAND));
+    fpGb.wReleaseDate(s(T::ORD_RELEASE_DATE));
+    fpGb.wVersion(Db::singleLine(s(T::ORD_VERSION)));
+    fpGb.wOriginalDescription(s(T::ORD_ORIGINAL_DESC));
+    fpGb.wLanguage(Db::singleLine(s(T::ORD_LANGUAGE)));
+    fpGb.wOrderTitle(Db::singleLine(s(T::ORD_ORDER_TITLE)));
+    fpGb.wLibrary(s(T::ORD_LIBRARY));
+    fpGb.wPlatformName(s(T::ORD_PLATFORM_NAME));
+    fpGb.wRuffleSupport(s(T::ORD_RUFFLE_SUPPORT));
+
+    return fpGb.build();
+}
+
+//===============================================================================================================
+// AddAppView
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Private:
+AddAppView::AddAppView(const void* row) : RowView(row) {}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+AddApp AddAppView::toAddApp() const
+{
+    using T = Db::Table_Add_App;
+    auto s = [&](T::Ordinal column){ return text(column).toString(); };
+
+    AddApp::Builder fpAab;
+    fpAab.wId(s(T::ORD_ID));
+    fpAab.wAppPath(s(T::ORD_APP_PATH));
+    fpAab.wAutorunBefore(integer(T::ORD_AUTORUN) != 0);
+    fpAab.wLaunchCommand(s(T::ORD_LAUNCH_COMMAND));
+    fpAab.wName(Db::singleLine(s(T::ORD_NAME)));
+    fpAab.wWaitExit(integer(T::ORD_WAIT_EXIT) != 0);
+    fpAab.wParentId(s(T::ORD_PARENT_ID));
+
+    return fpAab.build();
+}
+
+//===============================================================================================================
+// GameDataView
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Private:
+GameDataView::GameDataView(const void* row) : RowView(row) {}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+GameData GameDataView::toGameData() const
+{
+    using T = Db::Table_Game_Data;
+    auto s = [&](T::Ordinal column){ return text(column).toString(); };
+
+    GameData::Builder fpGdb;
+    fpGdb.wId(static_cast<quint32>(integer(T::ORD_ID)));
+    fpGdb.wGameId(s(T::ORD_GAME_ID));
+    fpGdb.wTitle(s(T::ORD_TITLE));
+    fpGdb.wDateAdded(s(T::ORD_DATE_ADDED));
+    fpGdb.wSha256(s(T::ORD_SHA256));
+    fpGdb.wCrc32(static_cast<quint32>(integer(T::ORD_CRC32)));
+    fpGdb.wPresentOnDisk(integer(T::ORD_PRES_ON_DISK) != 0);
+    fpGdb.wPath(s(T::ORD_PATH));
+    fpGdb.wSize(static_cast<quint32>(integer(T::ORD_SIZE)));
+    fpGdb.wRawParameters(s(T::ORD_PARAM));
+    fpGdb.wAppPath(s(T::ORD_APP_PATH));
+    fpGdb.wLaunchCommand(s(T::ORD_LAUNCH_COMMAND));
+
+    return fpGdb.build();
+}
+
+}
@@ -0,0 +1,139 @@
+// Unit Includes
+#include "fp/fp-gamerecord.h"
+
+// Project Includes
+#include "fp-recordcodec.h"
+
+namespace Fp
+{
+
+//===============================================================================================================
+// GameRecordSet
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Private:
+GameRecordSet::GameRecordSet(bool hasLongText) :
+    mStrings{QString()},
+    mHasLongText(hasLongText)
+{}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Private:
+QDateTime GameRecordSet::fromEpoch(qint64 epoch, Qt::TimeSpec spec)
+{
+    return epoch == Snapshot::NO_DATE ? QDateTime() : QDateTime::fromMSecsSinceEpoch(epoch, spec);
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Private:
+void GameRecordSet::append(const Game& game, QHash<QString, GameRecord::StringId>& interned)
+{
+    auto i = [&](const QString& string){ return RecordCodec::intern(mStrings, interned, string); };
+
+    quint32 longText = NO_TEXT;
+    if(mHasLongText && !(game.notes().isEmpty() && game.originalDescription().isEmpty()))
+    {
+        longText = mLongText.size();
+        mLongText.append({.notes = game.notes(), .originalDescription = game.originalDescription()});
+    }
+
+    mIndex.insert(game.id(), mRecords.size());
+    mRecords.append({
+        .id = game.id(),
+        .dateAdded = RecordCodec::toEpoch(game.dateAdded()),
+        .dateModified = RecordCodec::toEpoch(game.dateModified()),
+        .releaseDate = RecordCodec::toEpoch(game.releaseDate()),
+        .title = i(game.title()),
+        .series = i(game.series()),
+        .developer = i(game.developer()),
+        .publisher = i(game.publisher()),
+        .playMode = i(game.playMode()),
+        .statusText = i(game.status()),
+        .source = i(game.source()),
+        .appPath = i(game.appPath()),
+        .launchCommand = i(game.launchCommand()),
+        .version = i(game.version()),
+        .language = i(game.language()),
+        .orderTitle = i(game.orderTitle()),
+        .libraryText = i(game.library()),
+        .platformName = i(game.platformName()),
+        .ruffleSupport = i(game.ruffleSupport()),
+        .longText = longText,
+        .statusFlags = static_cast<quint8>(RecordCodec::parseStatus(game.status()).toInt()),
+        .library = RecordCodec::parseLibrary(game.library()),
+        .broken = game.isBroken()
+    });
+}
+
+void GameRecordSet::seal()
+{
+    // Drop the growth slack, the set never changes from here on
+    mRecords.squeeze();
+    mStrings.squeeze();
+    mLongText.squeeze();
+}
+
+//Public:
+bool GameRecordSet::isEmpty() const { return mRecords.isEmpty(); }
+qsizetype GameRecordSet::size() const { return mRecords.size(); }
+bool GameRecordSet::hasLongText() const { return mHasLongText; }
+
+std::span<const GameRecord> GameRecordSet::records() const
+{
+    return {mRecords.constData(), static_cast<size_t>(mRecords.size())};
+}
+
+const GameRecord& GameRecordSet::at(qsizetype i) const { return mRecords.at(i); }
+
+const GameRecord* GameRecordSet::find(const QUuid& id) const
+{
+    auto itr = mIndex.constFind(id);
+    return itr != mIndex.constEnd() ? &mRecords.at(*itr) : nullptr;
+}
+
+const QString& GameRecordSet::string(GameRecord::StringId id) const { return mStrings.at(id); }
+
+QString GameRecordSet::notes(const GameRecord& record) const
+{
+    return record.longText != NO_TEXT ? mLongText.at(record.longText).notes : QString();
+}
+
+QString GameRecordSet::originalDescription(const GameRecord& record) const
+{
+    return record.longText != NO_TEXT ? mLongText.at(record.longText).originalDescription : QString();
+}
+
+Game GameRecordSet::toGame(const GameRecord& record) const
+{
+    /* Strings are shared with the set rather than copied. The set dedupes across all fields, so a pooled field may hold
+     * another field's copy of the same text and is interned again by the builder.
+     */
+    Game::Builder fpGb;
+    fpGb.wId(record.id);
+    fpGb.wTitle(string(record.title));
+    fpGb.wSeries(string(record.series));
+    fpGb.wDeveloper(string(record.developer));
+    fpGb.wPublisher(string(record.publisher));
+    fpGb.wDateAdded(fromEpoch(record.dateAdded, Qt::UTC));
+    fpGb.wDateModified(fromEpoch(record.dateModified, Qt::UTC));
+    fpGb.wBroken(record.broken);
+    fpGb.wPlayMode(string(record.playMode));
+    fpGb.wStatus(string(record.statusText));
+    fpGb.wNotes(notes(record));
+    fpGb.wSource(string(record.source));
+    fpGb.wAppPath(string(record.appPath));
+    fpGb.wLaunchCommand(string(record.launchCommand));
+    fpGb.wReleaseDate(fromEpoch(record.releaseDate, Qt::LocalTime));
+    fpGb.wVersion(string(record.version));
+    fpGb.wOriginalDescription(originalDescription(record));
+    fpGb.wLanguage(string(record.language));
+    fpGb.wOrderTitle(string(record.orderTitle));
+    fpGb.wLibrary(string(record.libraryText));
+    fpGb.wPlatformName(string(record.platformName));
+    fpGb.wRuffleSupport(string(record.ruffleSupport));
+
+    return fpGb.build();
+}
+
+}
@@ -35,7 +35,7 @@ QString InstallError::deriveSecondary() const { return mSpecific; }
 
 //-Constructor------------------------------------------------------------------------------------------------
 //Public:
-Install::Install(QString installPath, bool preloadPlaylists) :
+Install::Install(QString installPath, bool preloadPlaylists, const Db::ConnectionProfile& dbProfile) :
     mValid(false) // Install is invalid until proven otherwise
 {
     QScopeGuard validityGuard([this](){ nullify(); }); // Automatically nullify on fail
@@ -147,7 +147,7 @@ Install::Install(QString installPath, bool preloadPlaylists) :
     establishDaemon();
 
     // Add database
-    mDatabase = new Db(mDatabaseFile->fileName(), {});
+    mDatabase = new Db(mDatabaseFile->fileName(), dbProfile, {});
 
     if(!mDatabase->isValid())
     {
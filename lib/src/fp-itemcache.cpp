@@ -0,0 +1,142 @@
+// Unit Includes
+#include "fp-itemcache.h"
+
+// Standard Library Includes
+#include <algorithm>
+
+namespace Fp
+{
+
+//===============================================================================================================
+// ItemCache
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+ItemCache::ItemCache() :
+    mCache(0), // Disabled until given a capacity
+    mHits(0),
+    mMisses(0),
+    mGeneration(0)
+{}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Private:
+qsizetype ItemCache::textSize(const Game& game)
+{
+    qsizetype chars = 0;
+    for(const QString& s : {game.title(), game.series(), game.developer(), game.publisher(), game.playMode(), game.status(), game.notes(),
+                            game.source(), game.appPath(), game.launchCommand(), game.version(), game.originalDescription(), game.language(),
+                            game.orderTitle(), game.library(), game.platformName(), game.ruffleSupport()})
+        chars += s.size();
+
+    return chars * sizeof(QChar);
+}
+
+qsizetype ItemCache::textSize(const AddApp& addApp)
+{
+    return (addApp.appPath().size() + addApp.launchCommand().size() + addApp.name().size()) * sizeof(QChar);
+}
+
+qsizetype ItemCache::textSize(const Entry& entry)
+{
+    return std::visit([](const auto& item){ return textSize(item); }, entry);
+}
+
+qsizetype ItemCache::textSize(const GameData& data)
+{
+    qsizetype chars = 0;
+    for(const QString& s : {data.title(), data.sha256(), data.path(), data.rawParameters(), data.appPath(), data.launchCommand()})
+        chars += s.size();
+
+    return chars * sizeof(QChar);
+}
+
+qsizetype ItemCache::textSize(const GameTags& tags)
+{
+    qsizetype chars = 0;
+    for(const QString& tag : tags.tags())
+        chars += tag.size();
+
+    return chars * sizeof(QChar);
+}
+
+qsizetype ItemCache::cost(const Item& item)
+{
+    // An estimate, text makes up most of an item and the rest is roughly fixed
+    return sizeof(Item) + std::visit([](const auto& value){ return textSize(value); }, item);
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+bool ItemCache::isEnabled() const
+{
+    QMutexLocker cacheLocker(&mMutex);
+    return mCache.maxCost() > 0;
+}
+
+quint64 ItemCache::generation() const
+{
+    QMutexLocker cacheLocker(&mMutex);
+    return mGeneration;
+}
+
+void ItemCache::setCapacity(qsizetype bytes)
+{
+    QMutexLocker cacheLocker(&mMutex);
+    mCache.setMaxCost(std::max(bytes, qsizetype(0))); // Evicts as needed
+}
+
+Db::ItemCacheStats ItemCache::stats() const
+{
+    QMutexLocker cacheLocker(&mMutex);
+    return {
+        .hits = mHits,
+        .misses = mMisses,
+        .items = mCache.count(),
+        .bytes = mCache.totalCost(),
+        .capacity = mCache.maxCost()
+    };
+}
+
+void ItemCache::removeGameData(const QList<int>& packIds)
+{
+    Q_ASSERT(std::is_sorted(packIds.cbegin(), packIds.cend()));
+    QMutexLocker cacheLocker(&mMutex);
+    mGeneration++;
+
+    // Data is cached by game, so find which games the packs belong to
+    const QList<Key> keys = mCache.keys();
+    for(const Key& key : keys)
+    {
+        if(key.kind != Kind::GameData)
+            continue;
+
+        const GameData& data = std::get<GameData>(*mCache.object(key));
+        if(!data.isNull() && std::binary_search(packIds.cbegin(), packIds.cend(), static_cast<int>(data.id())))
+            mCache.remove(key);
+    }
+}
+
+void ItemCache::clear()
+{
+    QMutexLocker cacheLocker(&mMutex);
+    mGeneration++;
+    mCache.clear();
+}
+
+void ItemCache::syncDataGeneration(quint64 generation)
+{
+    QMutexLocker cacheLocker(&mMutex);
+
+    // Anything could have changed
+    if(mDataGeneration && *mDataGeneration != generation)
+    {
+        mGeneration++;
+        mCache.clear();
+    }
+
+    mDataGeneration = generation;
+}
+
+}
@@ -0,0 +1,120 @@
+#ifndef FLASHPOINT_ITEMCACHE_H
+#define FLASHPOINT_ITEMCACHE_H
+
+// Standard Library Includes
+#include <variant>
+
+// Qt Includes
+#include <QCache>
+#include <QMutex>
+
+// Project Includes
+#include "fp/fp-db.h"
+
+namespace Fp
+{
+
+class ItemCache
+{
+//-Class Enums---------------------------------------------------------------------------------------------------
+private:
+    enum class Kind : quint8 { Entry, GameData, GameTags };
+
+//-Aliases-------------------------------------------------------------------------------------------------------
+private:
+    using Item = std::variant<Entry, GameData, GameTags>;
+
+//-Structs-----------------------------------------------------------------------------------------------------
+private:
+    struct Key
+    {
+        Kind kind;
+        QUuid id;
+
+        friend bool operator==(const Key& lhs, const Key& rhs) noexcept = default;
+        friend size_t qHash(const Key& key, size_t seed) noexcept { return qHashMulti(seed, static_cast<quint8>(key.kind), key.id); }
+    };
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    mutable QMutex mMutex;
+    QCache<Key, Item> mCache; // Cost is in bytes
+    quint64 mHits;
+    quint64 mMisses;
+    quint64 mGeneration; // Bumped by every invalidation
+    std::optional<quint64> mDataGeneration; // Of the database, see Db::dataGeneration()
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    ItemCache();
+
+//-Class Functions--------------------------------------------------------------------------------------------
+private:
+    template<typename T>
+    static constexpr Kind kindOf()
+    {
+        if constexpr(std::is_same_v<T, Entry>)
+            return Kind::Entry;
+        else if constexpr(std::is_same_v<T, GameData>)
+            return Kind::GameData;
+        else
+        {
+            static_assert(std::is_same_v<T, GameTags>, "Unsupported cache item type");
+            return Kind::GameTags;
+        }
+    }
+
+    static qsizetype textSize(const Game& game);
+    static qsizetype textSize(const AddApp& addApp);
+    static qsizetype textSize(const Entry& entry);
+    static qsizetype textSize(const GameData& data);
+    static qsizetype textSize(const GameTags& tags);
+    static qsizetype cost(const Item& item);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    bool isEnabled() const;
+    quint64 generation() const; // Take before reading an item from the database, then insert with it
+    void setCapacity(qsizetype bytes);
+    Db::ItemCacheStats stats() const;
+
+    template<typename T>
+    bool find(const QUuid& id, T& item)
+    {
+        QMutexLocker cacheLocker(&mMutex);
+        if(mCache.maxCost() == 0)
+            return false;
+
+        if(const Item* cached = mCache.object({kindOf<T>(), id}))
+        {
+            mHits++;
+            item = std::get<T>(*cached);
+            return true;
+        }
+
+        mMisses++;
+        return false;
+    }
+
+    template<typename T>
+    void insert(const QUuid& id, const T& item, quint64 generation)
+    {
+        // Items read before an invalidation may predate it, so those are dropped
+        QMutexLocker cacheLocker(&mMutex);
+        if(mCache.maxCost() == 0 || generation != mGeneration)
+            return;
+
+        auto cached = new Item(item);
+        mCache.insert({kindOf<T>(), id}, cached, cost(*cached)); // Takes ownership, even if too large to keep
+    }
+
+    void removeGameData(const QList<int>& packIds); // IDs must be sorted
+    void clear();
+
+    // External changes
+    void syncDataGeneration(quint64 generation);
+};
+
+}
+
+#endif // FLASHPOINT_ITEMCACHE_H
@@ -9,9 +9,27 @@
 #include <qx/core/qx-string.h>
 #include <qx/core/qx-algorithm.h>
 
+// Project Includes
+#include "fp-stringpool.h"
+
 namespace Fp
 {
 
+//===============================================================================================================
+// Atom
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Private:
+Atom::Atom(const QString& pooled) : mData(pooled.isEmpty() ? nullptr : pooled.constData()) {}
+
+//Public:
+Atom::Atom() : mData(nullptr) {}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+bool Atom::isEmpty() const { return !mData; }
+
 //===============================================================================================================
 // Game
 //===============================================================================================================
@@ -45,6 +63,15 @@ QString Game::library() const { return mLibrary; }
 QString Game::platformName() const { return mPlatformName; }
 QString Game::ruffleSupport() const { return mRuffleSupport; }
 
+Atom Game::developerAtom() const { return Atom(mDeveloper); }
+Atom Game::publisherAtom() const { return Atom(mPublisher); }
+Atom Game::playModeAtom() const { return Atom(mPlayMode); }
+Atom Game::statusAtom() const { return Atom(mStatus); }
+Atom Game::languageAtom() const { return Atom(mLanguage); }
+Atom Game::libraryAtom() const { return Atom(mLibrary); }
+Atom Game::platformNameAtom() const { return Atom(mPlatformName); }
+Atom Game::ruffleSupportAtom() const { return Atom(mRuffleSupport); }
+
 //===============================================================================================================
 // Game::Builder
 //===============================================================================================================
@@ -75,30 +102,38 @@ QString Game::Builder::kosherizeRawDate(const QString& date)
         return QString(); // Invalid date provided
 }
 
+// Every value of a pooled field must be the pooled copy, Atom relies on it
+QString Game::Builder::pooled(const QString& str) { return StringPool::instance().intern(str); }
+
 //-Instance Functions------------------------------------------------------------------------------------------
 //Public:
 Game::Builder& Game::Builder::wId(QStringView rawId) { mGameBlueprint.mId = QUuid(rawId); return *this; }
+Game::Builder& Game::Builder::wId(const QUuid& id) { mGameBlueprint.mId = id; return *this; }
 Game::Builder& Game::Builder::wTitle(const QString& title) { mGameBlueprint.mTitle = title; return *this; }
 Game::Builder& Game::Builder::wSeries(const QString& series) { mGameBlueprint.mSeries = series; return *this; }
-Game::Builder& Game::Builder::wDeveloper(const QString& developer) { mGameBlueprint.mDeveloper = developer; return *this; }
-Game::Builder& Game::Builder::wPublisher(const QString& publisher) { mGameBlueprint.mPublisher = publisher; return *this; }
+Game::Builder& Game::Builder::wDeveloper(const QString& developer) { mGameBlueprint.mDeveloper = pooled(developer); return *this; }
+Game::Builder& Game::Builder::wPublisher(const QString& publisher) { mGameBlueprint.mPublisher = pooled(publisher); return *this; }
 Game::Builder& Game::Builder::wDateAdded(QStringView rawDateAdded) { mGameBlueprint.mDateAdded = QDateTime::fromString(rawDateAdded, Qt::ISODateWithMs); return *this; }
+Game::Builder& Game::Builder::wDateAdded(const QDateTime& dateAdded) { mGameBlueprint.mDateAdded = dateAdded; return *this; }
 Game::Builder& Game::Builder::wDateModified(QStringView rawDateModified) { mGameBlueprint.mDateModified = QDateTime::fromString(rawDateModified, Qt::ISODateWithMs); return *this; }
+Game::Builder& Game::Builder::wDateModified(const QDateTime& dateModified) { mGameBlueprint.mDateModified = dateModified; return *this; }
 Game::Builder& Game::Builder::wBroken(QStringView rawBroken)  { mGameBlueprint.mBroken = rawBroken.toInt() != 0; return *this; }
-Game::Builder& Game::Builder::wPlayMode(const QString& playMode) { mGameBlueprint.mPlayMode = playMode; return *this; }
-Game::Builder& Game::Builder::wStatus(const QString& status) { mGameBlueprint.mStatus = status; return *this; }
+Game::Builder& Game::Builder::wBroken(bool broken)  { mGameBlueprint.mBroken = broken; return *this; }
+Game::Builder& Game::Builder::wPlayMode(const QString& playMode) { mGameBlueprint.mPlayMode = pooled(playMode); return *this; }
+Game::Builder& Game::Builder::wStatus(const QString& status) { mGameBlueprint.mStatus = pooled(status); return *this; }
 Game::Builder& Game::Builder::wNotes(const QString& notes)  { mGameBlueprint.mNotes = notes; return *this; }
 Game::Builder& Game::Builder::wSource(const QString& source)  { mGameBlueprint.mSource = source; return *this; }
 Game::Builder& Game::Builder::wAppPath(const QString& appPath)  { mGameBlueprint.mAppPath = appPath; return *this; }
 Game::Builder& Game::Builder::wLaunchCommand(const QString& launchCommand) { mGameBlueprint.mLaunchCommand = launchCommand; return *this; }
 Game::Builder& Game::Builder::wReleaseDate(QStringView rawReleaseDate)  { mGameBlueprint.mReleaseDate = QDateTime::fromString(kosherizeRawDate(rawReleaseDate.toString()), Qt::ISODate); return *this; }
+Game::Builder& Game::Builder::wReleaseDate(const QDateTime& releaseDate)  { mGameBlueprint.mReleaseDate = releaseDate; return *this; }
 Game::Builder& Game::Builder::wVersion(const QString& version)  { mGameBlueprint.mVersion = version; return *this; }
 Game::Builder& Game::Builder::wOriginalDescription(const QString& originalDescription)  { mGameBlueprint.mOriginalDescription = originalDescription; return *this; }
-Game::Builder& Game::Builder::wLanguage(const QString& language)  { mGameBlueprint.mLanguage = language; return *this; }
+Game::Builder& Game::Builder::wLanguage(const QString& language)  { mGameBlueprint.mLanguage = pooled(language); return *this; }
 Game::Builder& Game::Builder::wOrderTitle(const QString& orderTitle)  { mGameBlueprint.mOrderTitle = orderTitle; return *this; }
-Game::Builder& Game::Builder::wLibrary(const QString& library) { mGameBlueprint.mLibrary = library; return *this; }
-Game::Builder& Game::Builder::wPlatformName(const QString& platformName) { mGameBlueprint.mPlatformName = platformName; return *this; }
-Game::Builder& Game::Builder::wRuffleSupport(const QString& ruffleSupport) { mGameBlueprint.mRuffleSupport = ruffleSupport; return *this; }
+Game::Builder& Game::Builder::wLibrary(const QString& library) { mGameBlueprint.mLibrary = pooled(library); return *this; }
+Game::Builder& Game::Builder::wPlatformName(const QString& platformName) { mGameBlueprint.mPlatformName = pooled(platformName); return *this; }
+Game::Builder& Game::Builder::wRuffleSupport(const QString& ruffleSupport) { mGameBlueprint.mRuffleSupport = pooled(ruffleSupport); return *this; }
 
 Game Game::Builder::build() { return mGameBlueprint; }
 
@@ -192,6 +227,7 @@ GameData::Builder::Builder() {}
 //-Instance Functions------------------------------------------------------------------------------------------
 //Public:
 GameData::Builder& GameData::Builder::wId(QStringView rawId) { mGameDataBlueprint.mId = rawId.toInt(); return *this; }
+GameData::Builder& GameData::Builder::wId(quint32 id) { mGameDataBlueprint.mId = id; return *this; }
 GameData::Builder& GameData::Builder::wGameId(QStringView rawId) { mGameDataBlueprint.mGameId = QUuid(rawId); return *this; }
 GameData::Builder& GameData::Builder::wTitle(const QString& title) { mGameDataBlueprint.mTitle = title; return *this; }
 
@@ -226,11 +262,15 @@ GameData::Builder& GameData::Builder::wDateAdded(const QString& rawDateAdded)
     return *this;
 }
 
+GameData::Builder& GameData::Builder::wDateAdded(const QDateTime& dateAdded) { mGameDataBlueprint.mDateAdded = dateAdded; return *this; }
 GameData::Builder& GameData::Builder::wSha256(const QString& sha256) { mGameDataBlueprint.mSha256 = sha256; return *this; }
 GameData::Builder& GameData::Builder::wCrc32(QStringView rawCrc32) { mGameDataBlueprint.mCrc32 = rawCrc32.toInt(); return *this; }
+GameData::Builder& GameData::Builder::wCrc32(quint32 crc32) { mGameDataBlueprint.mCrc32 = crc32; return *this; }
 GameData::Builder& GameData::Builder::wPresentOnDisk(QStringView rawBroken) { mGameDataBlueprint.mPresentOnDisk = rawBroken.toInt() != 0; return *this; }
+GameData::Builder& GameData::Builder::wPresentOnDisk(bool presentOnDisk) { mGameDataBlueprint.mPresentOnDisk = presentOnDisk; return *this; }
 GameData::Builder& GameData::Builder::wPath(const QString& path) { mGameDataBlueprint.mPath = path; return *this; }
 GameData::Builder& GameData::Builder::wSize(QStringView rawSize) { mGameDataBlueprint.mSize = rawSize.toInt(); return *this; }
+GameData::Builder& GameData::Builder::wSize(quint32 size) { mGameDataBlueprint.mSize = size; return *this; }
 GameData::Builder& GameData::Builder::wRawParameters(const QString& parameters) { mGameDataBlueprint.mRawParameters = parameters; return *this; }
 GameData::Builder& GameData::Builder::wAppPath(const QString& appPath) { mGameDataBlueprint.mAppPath = appPath; return *this; }
 GameData::Builder& GameData::Builder::wLaunchCommand(const QString& launchCommand) { mGameDataBlueprint.mLaunchCommand = launchCommand; return *this; }
@@ -331,9 +371,11 @@ AddApp::Builder::Builder() {}
 AddApp::Builder& AddApp::Builder::wId(QStringView rawId) { mAddAppBlueprint.mId = QUuid(rawId); return *this; }
 AddApp::Builder& AddApp::Builder::wAppPath(const QString& appPath) { mAddAppBlueprint.mAppPath = appPath; return *this; }
 AddApp::Builder& AddApp::Builder::wAutorunBefore(QStringView rawAutorunBefore)  { mAddAppBlueprint.mAutorunBefore = rawAutorunBefore.toInt() != 0; return *this; }
+AddApp::Builder& AddApp::Builder::wAutorunBefore(bool autorunBefore)  { mAddAppBlueprint.mAutorunBefore = autorunBefore; return *this; }
 AddApp::Builder& AddApp::Builder::wLaunchCommand(const QString& launchCommand) { mAddAppBlueprint.mLaunchCommand = launchCommand; return *this; }
 AddApp::Builder& AddApp::Builder::wName(const QString& name) { mAddAppBlueprint.mName = name; return *this; }
 AddApp::Builder& AddApp::Builder::wWaitExit(QStringView rawWaitExit)  { mAddAppBlueprint.mWaitExit = rawWaitExit.toInt() != 0; return *this; }
+AddApp::Builder& AddApp::Builder::wWaitExit(bool waitExit)  { mAddAppBlueprint.mWaitExit = waitExit; return *this; }
 AddApp::Builder& AddApp::Builder::wParentId(QStringView rawParentId) { mAddAppBlueprint.mParentId = QUuid(rawParentId); return *this; }
 
 AddApp AddApp::Builder::build() { return mAddAppBlueprint; }
@@ -0,0 +1,195 @@
+// Unit Includes
+#include "fp-metadatacache.h"
+
+// Qt Includes
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QtEndian>
+
+// Project Includes
+#include "fp-stringpool.h"
+
+namespace Fp
+{
+
+//===============================================================================================================
+// MetadataCache
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+MetadataCache::MetadataCache(const QString& cachePath, const QString& sourcePath) :
+    mCachePath(cachePath),
+    mSourcePath(sourcePath)
+{}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Private:
+QByteArray MetadataCache::specsFingerprint()
+{
+    // A newer version of the library may require more of the database, in which case the old validation doesn't count
+    static const QByteArray fingerprint = []{
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        for(const Db::TableSpecs& spec : Db::DATABASE_SPECS_LIST)
+        {
+            hash.addData(spec.name.toUtf8());
+            hash.addData(spec.columns.join(u',').toUtf8());
+            hash.addData(QByteArrayView(";"));
+        }
+        return hash.result();
+    }();
+
+    return fingerprint;
+}
+
+//Public:
+std::optional<MetadataCache::Stamp> MetadataCache::stampOf(const QString& sourcePath)
+{
+    QFileInfo sourceInfo(sourcePath);
+    QString canonicalPath = sourceInfo.canonicalFilePath();
+    if(canonicalPath.isEmpty())
+        return std::nullopt;
+
+    // Header counters catch changes that keep the size and land within the same mtime tick
+    QFile source(canonicalPath);
+    if(!source.open(QIODevice::ReadOnly))
+        return std::nullopt;
+
+    QByteArray header = source.read(HEADER_SIZE);
+    if(header.size() != HEADER_SIZE || !header.startsWith(HEADER_STRING))
+        return std::nullopt;
+
+    // Writes to a database in WAL mode only touch the main file on checkpoint, so consider the WAL too
+    QFileInfo walInfo(canonicalPath + u"-wal"_s);
+    bool hasWal = walInfo.exists() && walInfo.size() > 0;
+
+    return Stamp{
+        .source = canonicalPath,
+        .size = sourceInfo.size(),
+        .modified = sourceInfo.lastModified().toMSecsSinceEpoch(),
+        .walSize = hasWal ? walInfo.size() : 0,
+        .walModified = hasWal ? walInfo.lastModified().toMSecsSinceEpoch() : 0,
+        .changeCounter = qFromBigEndian<quint32>(header.constData() + HEADER_CHANGE_COUNTER_OFFSET),
+        .schemaCookie = qFromBigEndian<quint32>(header.constData() + HEADER_SCHEMA_COOKIE_OFFSET),
+        .specs = specsFingerprint()
+    };
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+std::optional<MetadataCache::Stamp> MetadataCache::stamp() const { return stampOf(mSourcePath); }
+
+std::shared_ptr<const Db::Metadata> MetadataCache::load(const Stamp& current) const
+{
+    QFile cacheFile(mCachePath);
+    if(!cacheFile.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    QDataStream in(&cacheFile);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    // Check that the cache is usable before reading the rest
+    quint32 magic, version;
+    in >> magic >> version;
+    if(magic != MAGIC || version != VERSION)
+        return nullptr;
+
+    Stamp cached;
+    in >> cached.source >> cached.size >> cached.modified >> cached.walSize >> cached.walModified >>
+          cached.changeCounter >> cached.schemaCookie >> cached.specs;
+    if(in.status() != QDataStream::Ok || cached != current)
+        return nullptr;
+
+    // Read metadata
+    auto metadata = std::make_shared<Db::Metadata>();
+    in >> metadata->platformNames >> metadata->playlistList;
+
+    // Same as when populated from the database, names are shared with games
+    for(QString& platformName : metadata->platformNames)
+        platformName = StringPool::instance().intern(platformName);
+
+    auto directory = std::make_shared<TagDirectory>();
+    qint32 categoryCount;
+    in >> categoryCount;
+    for(qint32 c = 0; c < categoryCount && in.status() == QDataStream::Ok; c++)
+    {
+        qint32 categoryId, tagCount;
+        QString name;
+        QColor color;
+        in >> categoryId >> name >> color >> tagCount;
+        directory->addCategory(categoryId, name, color);
+
+        for(qint32 t = 0; t < tagCount && in.status() == QDataStream::Ok; t++)
+        {
+            qint32 tagId;
+            QString primaryAlias;
+            in >> tagId >> primaryAlias;
+            directory->addTag(tagId, primaryAlias, categoryId);
+        }
+    }
+    directory->seal();
+    metadata->tagDirectory = std::move(directory);
+
+    qint32 redirectCount;
+    in >> redirectCount;
+    metadata->gameRedirects.reserve(std::max(redirectCount, 0));
+    for(qint32 r = 0; r < redirectCount && in.status() == QDataStream::Ok; r++)
+    {
+        QUuid source, target;
+        in >> source >> target;
+        metadata->gameRedirects.insert(source, target);
+    }
+
+    if(in.status() != QDataStream::Ok || !in.atEnd())
+        return nullptr;
+
+    return metadata;
+}
+
+bool MetadataCache::save(const Db::Metadata& metadata, const Stamp& stamp) const
+{
+    // Only a cache, so failing to write one is not an error for the caller
+    QDir().mkpath(QFileInfo(mCachePath).absolutePath());
+
+    // Replace atomically so that a concurrent reader never sees a partial file
+    QSaveFile cacheFile(mCachePath);
+    if(!cacheFile.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&cacheFile);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    out << MAGIC << VERSION;
+    out << stamp.source << stamp.size << stamp.modified << stamp.walSize << stamp.walModified <<
+           stamp.changeCounter << stamp.schemaCookie << stamp.specs;
+
+    // Write metadata, tag lookups are rebuilt on load
+    out << metadata.platformNames << metadata.playlistList;
+
+    const TagDirectory& directory = *metadata.tagDirectory;
+    out << qint32(directory.categoryCount());
+    for(const TagDirectory::Category& category : directory.categories())
+    {
+        out << qint32(category.id) << category.name << category.color << qint32(category.tagCount);
+        for(const Db::Tag& tag : directory.tags(category))
+            out << qint32(tag.id) << tag.primaryAlias;
+    }
+
+    out << qint32(metadata.gameRedirects.size());
+    for(auto itr = metadata.gameRedirects.cbegin(); itr != metadata.gameRedirects.cend(); ++itr)
+        out << itr.key() << itr.value();
+
+    if(out.status() != QDataStream::Ok)
+    {
+        cacheFile.cancelWriting();
+        return false;
+    }
+
+    return cacheFile.commit();
+}
+
+}
@@ -0,0 +1,75 @@
+#ifndef FLASHPOINT_METADATACACHE_H
+#define FLASHPOINT_METADATACACHE_H
+
+// Qt Includes
+#include <QString>
+#include <QByteArray>
+
+// Project Includes
+#include "fp/fp-db.h"
+#include "fp/fp-tagdirectory.h"
+
+namespace Fp
+{
+
+/* Persists Db metadata between runs so that opening an unchanged database can skip schema validation and the scans
+ * that build the metadata. Only metadata from a database that passed validation is ever saved.
+ */
+class MetadataCache
+{
+//-Structs-----------------------------------------------------------------------------------------------------
+public:
+    // Identifies the exact state of a database file, cached data is only used if all of it still matches
+    struct Stamp
+    {
+        QString source; // Canonical path
+        qint64 size;
+        qint64 modified; // Epoch ms
+        qint64 walSize; // 0 if there is no WAL or it's empty
+        qint64 walModified;
+        quint32 changeCounter; // From the database header
+        quint32 schemaCookie; // From the database header
+        QByteArray specs; // Fingerprint of the tables and columns the library requires
+
+        friend bool operator==(const Stamp& lhs, const Stamp& rhs) noexcept = default;
+    };
+
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static constexpr quint32 MAGIC = 0x46504D43; // "FPMC"
+
+    // Increment whenever the layout or meaning of the cached data changes so that stale caches are ignored
+    static const quint32 VERSION = 4;
+
+    // SQLite file header
+    static inline const QByteArray HEADER_STRING = QByteArrayLiteral("SQLite format 3\0");
+    static const int HEADER_SIZE = 100;
+    static const int HEADER_CHANGE_COUNTER_OFFSET = 24;
+    static const int HEADER_SCHEMA_COOKIE_OFFSET = 40;
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    const QString mCachePath;
+    const QString mSourcePath;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    MetadataCache(const QString& cachePath, const QString& sourcePath);
+
+//-Class Functions--------------------------------------------------------------------------------------------
+private:
+    static QByteArray specsFingerprint();
+
+public:
+    static std::optional<Stamp> stampOf(const QString& sourcePath);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    std::optional<Stamp> stamp() const;
+    std::shared_ptr<const Db::Metadata> load(const Stamp& current) const;
+    bool save(const Db::Metadata& metadata, const Stamp& stamp) const;
+};
+
+}
+
+#endif // FLASHPOINT_METADATACACHE_H
@@ -0,0 +1,151 @@
+// Unit Includes
+#include "fp-nativereader.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <vector>
+
+// SQLite Includes
+#include <sqlite3.h>
+
+namespace Fp
+{
+
+namespace
+{
+    struct ThreadReader
+    {
+        std::weak_ptr<NativeReaderPool> pool;
+        const NativeReaderPool* poolAddress;
+        std::shared_ptr<NativeReader> reader; // In use while shared
+    };
+
+    thread_local std::vector<ThreadReader> tReaders;
+}
+
+//===============================================================================================================
+// NativeReader
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+NativeReader::NativeReader() :
+    mHandle(nullptr),
+    mStatement(nullptr)
+{}
+
+//-Destructor------------------------------------------------------------------------------------------------
+//Public:
+NativeReader::~NativeReader()
+{
+    sqlite3_finalize(mStatement);
+    sqlite3_close_v2(mHandle);
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Private:
+QSqlError NativeReader::handleError(QSqlError::ErrorType type)
+{
+    mError = QSqlError(QString::fromUtf8(sqlite3_errmsg(mHandle)), {}, type, QString::number(sqlite3_extended_errcode(mHandle)));
+    return mError;
+}
+
+//Public:
+QSqlError NativeReader::open(const QString& path, const Db::ConnectionProfile& profile)
+{
+    // Bulk reads never write, and this handle is never shared between threads
+    int flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX | SQLITE_OPEN_URI;
+    QUrl dbUrl = QUrl::fromLocalFile(QFileInfo(path).absoluteFilePath());
+    if(profile.immutable)
+        dbUrl.setQuery(u"immutable=1"_s);
+
+    if(sqlite3_open_v2(dbUrl.toString(QUrl::FullyEncoded).toUtf8().constData(), &mHandle, flags, nullptr) != SQLITE_OK)
+        return handleError(QSqlError::ConnectionError);
+
+    QStringList pragmas;
+    if(profile.mmapSize > 0)
+        pragmas.append(u"PRAGMA mmap_size = "_s + QString::number(profile.mmapSize));
+    if(profile.cacheSize > 0)
+        pragmas.append(u"PRAGMA cache_size = -"_s + QString::number(profile.cacheSize));
+    if(profile.tempStoreMemory)
+        pragmas.append(u"PRAGMA temp_store = MEMORY"_s);
+
+    if(!pragmas.isEmpty() && sqlite3_exec(mHandle, pragmas.join(';').toUtf8().constData(), nullptr, nullptr, nullptr) != SQLITE_OK)
+        return handleError(QSqlError::ConnectionError);
+
+    return QSqlError();
+}
+
+QSqlError NativeReader::prepare(const QString& command)
+{
+    // Readers are reused, so an error left over from an earlier statement mustn't carry over to this one
+    sqlite3_finalize(mStatement);
+    mStatement = nullptr;
+    mError = QSqlError();
+
+    QByteArray utf8Command = command.toUtf8();
+    if(sqlite3_prepare_v3(mHandle, utf8Command.constData(), utf8Command.size(), 0, &mStatement, nullptr) != SQLITE_OK)
+        return handleError(QSqlError::StatementError);
+
+    return QSqlError();
+}
+
+bool NativeReader::step()
+{
+    int result = sqlite3_step(mStatement);
+    if(result == SQLITE_ROW)
+        return true;
+
+    if(result != SQLITE_DONE)
+        handleError(QSqlError::StatementError);
+
+    return false;
+}
+
+void NativeReader::finish()
+{
+    // A statement left partway through would keep its read transaction open
+    sqlite3_finalize(mStatement);
+    mStatement = nullptr;
+}
+
+const void* NativeReader::row() const { return mStatement; }
+QSqlError NativeReader::error() const { return mError; }
+
+//===============================================================================================================
+// NativeReaderPool
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+NativeReaderPool::NativeReaderPool(const QString& path, const Db::ConnectionProfile& profile) :
+    mPath(path),
+    mProfile(profile)
+{}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+QSqlError NativeReaderPool::acquire(std::shared_ptr<NativeReader>& reader)
+{
+    // Drop readers of pools that are gone
+    std::erase_if(tReaders, [](const ThreadReader& r){ return r.pool.expired(); });
+
+    auto itr = std::find_if(tReaders.begin(), tReaders.end(), [this](const ThreadReader& r){ return r.poolAddress == this; });
+    if(itr != tReaders.end() && itr->reader.use_count() == 1)
+    {
+        reader = itr->reader;
+        return QSqlError();
+    }
+
+    auto fresh = std::make_shared<NativeReader>();
+    if(QSqlError openError = fresh->open(mPath, mProfile); openError.isValid())
+        return openError;
+
+    if(itr == tReaders.end())
+        tReaders.push_back(ThreadReader{.pool = weak_from_this(), .poolAddress = this, .reader = fresh});
+
+    reader = std::move(fresh);
+    return QSqlError();
+}
+
+}
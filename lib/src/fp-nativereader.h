@@ -0,0 +1,70 @@
+#ifndef FLASHPOINT_NATIVEREADER_H
+#define FLASHPOINT_NATIVEREADER_H
+
+// Standard Library Includes
+#include <memory>
+
+// Qt Includes
+#include <QtSql>
+
+// Project Includes
+#include "fp/fp-db.h"
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace Fp
+{
+
+class NativeReader
+{
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    sqlite3* mHandle;
+    sqlite3_stmt* mStatement;
+    QSqlError mError;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    NativeReader();
+
+//-Destructor-------------------------------------------------------------------------------------------------
+public:
+    ~NativeReader();
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    QSqlError handleError(QSqlError::ErrorType type);
+
+public:
+    QSqlError open(const QString& path, const Db::ConnectionProfile& profile);
+    QSqlError prepare(const QString& command);
+    bool step();
+    void finish();
+
+    const void* row() const;
+    QSqlError error() const; // Of the current statement
+};
+
+/* Keeps one reader per thread so that bulk reads don't reopen the file each time. A thread's readers are closed when
+ * it exits, or on its next acquisition once their pool is gone. Nested use on one thread gets an extra, uncached reader.
+ */
+class NativeReaderPool : public std::enable_shared_from_this<NativeReaderPool>
+{
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    const QString mPath;
+    const Db::ConnectionProfile mProfile;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    NativeReaderPool(const QString& path, const Db::ConnectionProfile& profile);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    QSqlError acquire(std::shared_ptr<NativeReader>& reader);
+};
+
+}
+
+#endif // FLASHPOINT_NATIVEREADER_H
@@ -0,0 +1,65 @@
+// Unit Includes
+#include "fp-recordcodec.h"
+
+// Project Includes
+#include "fp/fp-db.h"
+
+namespace Fp
+{
+
+namespace RecordCodec
+{
+
+qint64 toEpoch(const QDateTime& dateTime) { return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : Snapshot::NO_DATE; }
+
+Snapshot::Status parseStatus(QStringView status)
+{
+    Snapshot::Status flags = Snapshot::NoStatus;
+
+    // Entries can have several statuses, i.e. "Partial; Hacked"
+    for(QStringView part : status.split(u';', Qt::SkipEmptyParts))
+    {
+        part = part.trimmed();
+        if(part.compare(u"Playable"_s, Qt::CaseInsensitive) == 0)
+            flags |= Snapshot::Playable;
+        else if(part.compare(u"Partial"_s, Qt::CaseInsensitive) == 0)
+            flags |= Snapshot::Partial;
+        else if(part.compare(u"Hacked"_s, Qt::CaseInsensitive) == 0)
+            flags |= Snapshot::Hacked;
+        else if(part.compare(Db::Table_Game::ENTRY_NOT_WORK, Qt::CaseInsensitive) == 0)
+            flags |= Snapshot::NotWorking;
+        else if(!part.isEmpty())
+            flags |= Snapshot::OtherStatus;
+    }
+
+    return flags;
+}
+
+Snapshot::Library parseLibrary(QStringView library)
+{
+    if(library == Db::Table_Game::ENTRY_GAME_LIBRARY)
+        return Snapshot::Library::Arcade;
+    else if(library == Db::Table_Game::ENTRY_ANIM_LIBRARY)
+        return Snapshot::Library::Theatre;
+    else
+        return Snapshot::Library::Other;
+}
+
+Snapshot::StringId intern(QStringList& strings, QHash<QString, Snapshot::StringId>& interned, const QString& string)
+{
+    if(string.isEmpty())
+        return 0;
+
+    auto itr = interned.constFind(string);
+    if(itr != interned.constEnd())
+        return *itr;
+
+    Snapshot::StringId id = strings.size();
+    strings.append(string);
+    interned.insert(string, id);
+    return id;
+}
+
+}
+
+}
@@ -0,0 +1,28 @@
+#ifndef FLASHPOINT_RECORDCODEC_H
+#define FLASHPOINT_RECORDCODEC_H
+
+// Qt Includes
+#include <QHash>
+#include <QStringList>
+#include <QDateTime>
+
+// Project Includes
+#include "fp/fp-snapshot.h"
+
+namespace Fp
+{
+
+// Encoding shared by the packed game stores, Snapshot and GameRecordSet
+namespace RecordCodec
+{
+    qint64 toEpoch(const QDateTime& dateTime); // Snapshot::NO_DATE if invalid
+    Snapshot::Status parseStatus(QStringView status);
+    Snapshot::Library parseLibrary(QStringView library);
+
+    // Id of string within strings, which is added if new. Id 0 is the empty string, interned holds the ids given so far
+    Snapshot::StringId intern(QStringList& strings, QHash<QString, Snapshot::StringId>& interned, const QString& string);
+}
+
+}
+
+#endif // FLASHPOINT_RECORDCODEC_H
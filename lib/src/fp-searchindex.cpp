@@ -0,0 +1,298 @@
+// Unit Includes
+#include "fp-searchindex.h"
+
+// Project Includes
+#include "fp/fp-db.h"
+
+namespace Fp
+{
+
+namespace
+{
+    /* Indexed game columns, in FTS column order. Additional apps only fill in the title. Alternate titles aren't part of
+     * the validated game schema, so they are only indexed when the source has them.
+     */
+    const QStringList& textColumns()
+    {
+        static const QStringList cols{
+            Db::Table_Game::COL_TITLE,
+            Db::Table_Game::COL_ALTERNATE_TITLES,
+            Db::Table_Game::COL_DEVELOPER,
+            Db::Table_Game::COL_PUBLISHER,
+            Db::Table_Game::COL_SERIES
+        };
+        return cols;
+    }
+}
+
+//===============================================================================================================
+// SearchIndex
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+SearchIndex::SearchIndex(const QString& sourcePath, const QString& indexPath, const QString& connectionName, int maxConnections,
+                         std::chrono::milliseconds idleTimeout) :
+    mSourcePath(sourcePath),
+    mIndexPath(indexPath),
+    mSchemaReady(false)
+{
+    // No path means the index only lives as long as this instance, but it still needs a file to be shared by connections
+    if(mIndexPath.isEmpty())
+    {
+        mTemporaryDir = std::make_unique<QTemporaryDir>();
+        mIndexPath = mTemporaryDir->filePath(u"search.sqlite"_s);
+    }
+
+    auto opener = [this](PooledConnection& connection, const QString& name){ return openConnection(connection.database, name); };
+    mConnectionPool = std::make_shared<ConnectionPool>(connectionName + u"_"_s, opener, maxConnections, idleTimeout);
+}
+
+//-Destructor------------------------------------------------------------------------------------------------
+//Public:
+SearchIndex::~SearchIndex() { mConnectionPool.reset(); } // Before the temporary dir goes
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Private:
+QSqlError SearchIndex::exec(QSqlDatabase& database, const QString& command, const QVariantMap& bindings)
+{
+    QSqlQuery query(database);
+    if(!query.prepare(command))
+        return query.lastError();
+
+    for(const auto [placeholder, value] : bindings.asKeyValueRange())
+        query.bindValue(placeholder, value);
+
+    if(!query.exec())
+        return query.lastError();
+
+    return QSqlError();
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Private:
+QDateTime SearchIndex::sourceStamp() const
+{
+    // Writes to a database in WAL mode only touch the main file on checkpoint, so consider both
+    QDateTime mainStamp = QFileInfo(mSourcePath).lastModified();
+    QDateTime walStamp = QFileInfo(mSourcePath + u"-wal"_s).lastModified();
+    return walStamp.isValid() && walStamp > mainStamp ? walStamp : mainStamp;
+}
+
+QSqlError SearchIndex::openConnection(QSqlDatabase& database, const QString& connectionName) const
+{
+    database = QSqlDatabase::addDatabase(u"QSQLITE"_s, connectionName);
+    database.setDatabaseName(mIndexPath);
+    if(database.open())
+        return QSqlError();
+
+    QSqlError openError = database.lastError();
+    database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(connectionName);
+    return openError;
+}
+
+QSqlError SearchIndex::prepareSchema(QSqlDatabase& database)
+{
+    QSqlError error;
+
+    // Lets searches on other connections go on while a sync is being written
+    if((error = exec(database, u"PRAGMA journal_mode = WAL"_s)).isValid() ||
+       (error = exec(database, u"CREATE TABLE IF NOT EXISTS "_s + TABLE_META + u"(key TEXT PRIMARY KEY, value TEXT)"_s)).isValid())
+        return error;
+
+    // Check if an existing index is compatible
+    QSqlQuery metaQuery(database);
+    if(!metaQuery.exec(u"SELECT key, value FROM "_s + TABLE_META))
+        return metaQuery.lastError();
+
+    QHash<QString, QString> meta;
+    while(metaQuery.next())
+        meta[metaQuery.value(0).toString()] = metaQuery.value(1).toString();
+    metaQuery.finish();
+
+    if(meta.value(META_VERSION) != VERSION || meta.value(META_SOURCE) != mSourcePath)
+    {
+        if((error = exec(database, u"DROP TABLE IF EXISTS "_s + TABLE_TEXT)).isValid() ||
+           (error = exec(database, u"DROP TABLE IF EXISTS "_s + TABLE_DOCS)).isValid())
+            return error;
+    }
+
+    /* Documents map entry IDs to FTS rowids and remember what each was indexed with, which is what lets later syncs
+     * only touch changed entries. Games are stamped with their modification date. Additional apps have none, so they
+     * are stamped with their name, the only column of theirs that is indexed (as a title). The trigram tokenizer
+     * allows arbitrary substring matches.
+     */
+    if((error = exec(database, u"CREATE TABLE IF NOT EXISTS "_s + TABLE_DOCS +
+                     u"(docId INTEGER PRIMARY KEY, id TEXT UNIQUE NOT NULL, kind INTEGER NOT NULL, stamp TEXT)"_s)).isValid())
+        return error;
+
+    if((error = exec(database, u"CREATE VIRTUAL TABLE IF NOT EXISTS "_s + TABLE_TEXT + u" USING fts5("_s + textColumns().join(u", "_s) +
+                     u", tokenize = 'trigram')"_s)).isValid())
+        return error;
+
+    QString metaInsert = u"INSERT OR REPLACE INTO "_s + TABLE_META + u"(key, value) VALUES(:key, :value)"_s;
+    if((error = exec(database, metaInsert, {{u":key"_s, META_VERSION}, {u":value"_s, VERSION}})).isValid() ||
+       (error = exec(database, metaInsert, {{u":key"_s, META_SOURCE}, {u":value"_s, mSourcePath}})).isValid())
+        return error;
+
+    return QSqlError();
+}
+
+QSqlError SearchIndex::sync(QSqlDatabase& database)
+{
+    // NOTE: Caller must hold mMutex
+    QSqlError error;
+    QDateTime stamp = sourceStamp();
+
+    // Attach source, which can't be done within a transaction
+    if((error = exec(database, u"ATTACH DATABASE :source AS "_s + SOURCE_SCHEMA, {{u":source"_s, mSourcePath}})).isValid())
+        return error;
+    QScopeGuard detachGuard([&database](){ exec(database, u"DETACH DATABASE "_s + SOURCE_SCHEMA); });
+
+    if(!database.transaction())
+        return database.lastError();
+    QScopeGuard rollbackGuard([&database](){ database.rollback(); });
+
+    const QString gTable = SOURCE_SCHEMA + u"."_s + Db::Table_Game::NAME;
+    const QString& gId = Db::Table_Game::COL_ID;
+    const QString& gMod = Db::Table_Game::COL_DATE_MODIFIED;
+    const QString aTable = SOURCE_SCHEMA + u"."_s + Db::Table_Add_App::NAME;
+    const QString& aId = Db::Table_Add_App::COL_ID;
+    const QString& aName = Db::Table_Add_App::COL_NAME;
+    const QVariantMap gKind{{u":kind"_s, KIND_GAME}};
+    const QVariantMap aKind{{u":kind"_s, KIND_ADD_APP}};
+
+    // Drop documents for entries that were removed or modified since they were indexed
+    if((error = exec(database, u"CREATE TEMP TABLE "_s + TABLE_STALE + u" AS SELECT d.docId AS docId FROM "_s + TABLE_DOCS + u" d LEFT JOIN "_s +
+                     gTable + u" g ON g."_s + gId + u" = d.id WHERE d.kind = :gameKind AND (g."_s + gId + u" IS NULL OR g."_s + gMod +
+                     u" IS NOT d.stamp) UNION ALL SELECT d.docId FROM "_s + TABLE_DOCS + u" d LEFT JOIN "_s + aTable + u" a ON a."_s + aId +
+                     u" = d.id WHERE d.kind = :addAppKind AND (a."_s + aId + u" IS NULL OR a."_s + aName + u" IS NOT d.stamp)"_s,
+                     {{u":gameKind"_s, KIND_GAME}, {u":addAppKind"_s, KIND_ADD_APP}})).isValid() ||
+       (error = exec(database, u"DELETE FROM "_s + TABLE_TEXT + u" WHERE rowid IN (SELECT docId FROM temp."_s + TABLE_STALE + u")"_s)).isValid() ||
+       (error = exec(database, u"DELETE FROM "_s + TABLE_DOCS + u" WHERE docId IN (SELECT docId FROM temp."_s + TABLE_STALE + u")"_s)).isValid() ||
+       (error = exec(database, u"DROP TABLE temp."_s + TABLE_STALE)).isValid())
+        return error;
+
+    // Note where new documents will start
+    QSqlQuery lastDocQuery(database);
+    if(!lastDocQuery.exec(u"SELECT IFNULL(MAX(docId), 0) FROM "_s + TABLE_DOCS) || !lastDocQuery.next())
+        return lastDocQuery.lastError();
+    qint64 lastDocId = lastDocQuery.value(0).toLongLong();
+    lastDocQuery.finish();
+
+    // (Re)index entries that don't have a document, columns missing from the source are indexed as empty
+    QSqlQuery columnQuery(database);
+    if(!columnQuery.exec(u"SELECT name FROM pragma_table_info('"_s + Db::Table_Game::NAME + u"', '"_s + SOURCE_SCHEMA + u"')"_s))
+        return columnQuery.lastError();
+    QSet<QString> sourceColumns;
+    while(columnQuery.next())
+        sourceColumns.insert(columnQuery.value(0).toString());
+    columnQuery.finish();
+
+    QStringList gTextColList;
+    for(const QString& column : textColumns())
+        gTextColList.append(sourceColumns.contains(column) ? u"g."_s + column : u"NULL"_s);
+    QString gTextCols = gTextColList.join(u", "_s);
+    QVariantMap gNew = gKind, aNew = aKind;
+    gNew[u":lastDocId"_s] = aNew[u":lastDocId"_s] = lastDocId;
+    if((error = exec(database, u"INSERT INTO "_s + TABLE_DOCS + u"(id, kind, stamp) SELECT "_s + gId + u", :kind, "_s + gMod + u" FROM "_s + gTable +
+                     u" WHERE "_s + gId + u" NOT IN (SELECT id FROM "_s + TABLE_DOCS + u")"_s, gKind)).isValid() ||
+       (error = exec(database, u"INSERT INTO "_s + TABLE_DOCS + u"(id, kind, stamp) SELECT "_s + aId + u", :kind, "_s + aName + u" FROM "_s + aTable +
+                     u" WHERE "_s + aId + u" NOT IN (SELECT id FROM "_s + TABLE_DOCS + u")"_s, aKind)).isValid() ||
+       (error = exec(database, u"INSERT INTO "_s + TABLE_TEXT + u"(rowid, "_s + textColumns().join(u", "_s) + u") SELECT d.docId, "_s + gTextCols +
+                     u" FROM "_s + TABLE_DOCS + u" d JOIN "_s + gTable + u" g ON g."_s + gId + u" = d.id WHERE d.kind = :kind AND d.docId > :lastDocId"_s,
+                     gNew)).isValid() ||
+       (error = exec(database, u"INSERT INTO "_s + TABLE_TEXT + u"(rowid, "_s + Db::Table_Game::COL_TITLE + u") SELECT d.docId, a."_s + aName +
+                     u" FROM "_s + TABLE_DOCS + u" d JOIN "_s + aTable + u" a ON a."_s + aId + u" = d.id WHERE d.kind = :kind AND d.docId > :lastDocId"_s,
+                     aNew)).isValid())
+        return error;
+
+    if(!database.commit())
+        return database.lastError();
+    rollbackGuard.dismiss();
+
+    mSourceStamp = stamp;
+    return QSqlError();
+}
+
+QSqlError SearchIndex::catchUp(QSqlDatabase& database, bool force)
+{
+    QMutexLocker indexLocker(&mMutex);
+
+    if(!mSchemaReady)
+    {
+        if(QSqlError schemaError = prepareSchema(database); schemaError.isValid())
+            return schemaError;
+        mSchemaReady = true;
+    }
+
+    if(force || !mSourceStamp.isValid() || sourceStamp() != mSourceStamp)
+        return sync(database);
+
+    return QSqlError();
+}
+
+//Public:
+QSqlError SearchIndex::update()
+{
+    std::shared_ptr<PooledConnection> connection;
+    if(QSqlError connectionError = mConnectionPool->acquire(connection); connectionError.isValid())
+        return connectionError;
+
+    return catchUp(connection->database, true);
+}
+
+QSqlError SearchIndex::search(QList<QUuid>& resultBuffer, const QString& text, int limit)
+{
+    // Ensure return buffer is reset
+    resultBuffer.clear();
+
+    QString term = text.trimmed();
+    if(term.isEmpty())
+        return QSqlError();
+
+    std::shared_ptr<PooledConnection> connection;
+    if(QSqlError connectionError = mConnectionPool->acquire(connection); connectionError.isValid())
+        return connectionError;
+
+    // Catch up with the source first if it has changed
+    if(QSqlError syncError = catchUp(connection->database, false); syncError.isValid())
+        return syncError;
+
+    QString baseCommand = u"SELECT d.id FROM "_s + TABLE_TEXT + u" JOIN "_s + TABLE_DOCS + u" d ON d.docId = "_s + TABLE_TEXT + u".rowid WHERE "_s;
+    QSqlQuery searchQuery(connection->database);
+    searchQuery.setForwardOnly(true);
+
+    if(term.size() >= MIN_MATCH_LENGTH)
+    {
+        // Match as a single phrase, which is a substring match with trigrams
+        if(!searchQuery.prepare(baseCommand + TABLE_TEXT + u" MATCH :term ORDER BY rank LIMIT :limit"_s))
+            return searchQuery.lastError();
+        searchQuery.bindValue(u":term"_s, u"\""_s + term.replace(u"\""_s, u"\"\""_s) + u"\""_s);
+    }
+    else
+    {
+        // Too short for the index, scan the (smaller) FTS content instead
+        QString escapedTerm = term;
+        escapedTerm.replace(uR"(\)"_s, uR"(\\)"_s);
+        escapedTerm.replace(uR"(%)"_s, uR"(\%)"_s);
+        escapedTerm.replace(uR"(_)"_s, uR"(\_)"_s);
+
+        QString likeFilter = textColumns().join(u" LIKE :term ESCAPE '\\' OR "_s) + u" LIKE :term ESCAPE '\\'"_s;
+        if(!searchQuery.prepare(baseCommand + u"("_s + likeFilter + u") LIMIT :limit"_s))
+            return searchQuery.lastError();
+        searchQuery.bindValue(u":term"_s, u"%"_s + escapedTerm + u"%"_s);
+    }
+    searchQuery.bindValue(u":limit"_s, limit);
+
+    if(!searchQuery.exec())
+        return searchQuery.lastError();
+
+    while(searchQuery.next())
+        resultBuffer.append(QUuid(searchQuery.value(0).toString()));
+
+    return QSqlError();
+}
+
+}
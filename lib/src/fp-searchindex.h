@@ -0,0 +1,84 @@
+#ifndef FLASHPOINT_SEARCHINDEX_H
+#define FLASHPOINT_SEARCHINDEX_H
+
+// Standard Library Includes
+#include <chrono>
+#include <memory>
+
+// Qt Includes
+#include <QtSql>
+#include <QTemporaryDir>
+
+// Project Includes
+#include "fp-connectionpool.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+namespace Fp
+{
+
+/* Full text index of games and additional apps, kept in a sidecar database. Each thread searches through its own
+ * connection, syncing with the source is serialized.
+ */
+class SearchIndex
+{
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    // Increment whenever the layout below changes so that stale sidecars get rebuilt
+    static inline const QString VERSION = u"2"_s;
+
+    static inline const QString SOURCE_SCHEMA = u"src"_s;
+    static inline const QString TABLE_META = u"search_meta"_s;
+    static inline const QString TABLE_DOCS = u"search_docs"_s;
+    static inline const QString TABLE_TEXT = u"search_text"_s;
+    static inline const QString TABLE_STALE = u"search_stale"_s;
+
+    static inline const QString META_VERSION = u"version"_s;
+    static inline const QString META_SOURCE = u"source"_s;
+
+    // Document kinds
+    static constexpr int KIND_GAME = 0;
+    static constexpr int KIND_ADD_APP = 1;
+
+    // Trigram tokens can't match anything shorter
+    static constexpr int MIN_MATCH_LENGTH = 3;
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QMutex mMutex; // Guards schema preparation and syncing
+    const QString mSourcePath;
+    std::unique_ptr<QTemporaryDir> mTemporaryDir; // Holds the index when no path is given
+    QString mIndexPath;
+    std::shared_ptr<ConnectionPool> mConnectionPool;
+    bool mSchemaReady;
+    QDateTime mSourceStamp;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+public:
+    SearchIndex(const QString& sourcePath, const QString& indexPath, const QString& connectionName, int maxConnections,
+                std::chrono::milliseconds idleTimeout);
+
+//-Destructor-------------------------------------------------------------------------------------------------
+public:
+    ~SearchIndex();
+
+//-Class Functions--------------------------------------------------------------------------------------------
+private:
+    static QSqlError exec(QSqlDatabase& database, const QString& command, const QVariantMap& bindings = {});
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    QDateTime sourceStamp() const;
+    QSqlError openConnection(QSqlDatabase& database, const QString& connectionName) const;
+    QSqlError prepareSchema(QSqlDatabase& database);
+    QSqlError sync(QSqlDatabase& database);
+    QSqlError catchUp(QSqlDatabase& database, bool force);
+
+public:
+    QSqlError update();
+    QSqlError search(QList<QUuid>& resultBuffer, const QString& text, int limit);
+};
+
+}
+
+#endif // FLASHPOINT_SEARCHINDEX_H
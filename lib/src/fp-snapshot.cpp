@@ -0,0 +1,306 @@
+// Unit Includes
+#include "fp/fp-snapshot.h"
+
+// Qt Includes
+#include <QTimeZone>
+
+// Project Includes
+#include "fp/fp-db.h"
+#include "fp-recordcodec.h"
+
+namespace Fp
+{
+
+//===============================================================================================================
+// Snapshot
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Private:
+Snapshot::Snapshot() :
+    mStrings{QString()}
+{}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Private:
+QDateTime Snapshot::fromEpoch(qint64 epoch)
+{
+    return epoch == NO_DATE ? QDateTime() : QDateTime::fromMSecsSinceEpoch(epoch, QTimeZone::UTC);
+}
+
+void Snapshot::groupByGame(QList<quint32>& offsets, QList<quint32>& rows, const QList<quint32>& gameRows, quint32 gameCount)
+{
+    // Counting sort of child rows by their parent, orphans are left out
+    offsets.fill(0, gameCount + 1);
+    for(quint32 gameRow : gameRows)
+        if(gameRow != NO_ROW)
+            offsets[gameRow + 1]++;
+
+    for(quint32 i = 0; i < gameCount; i++)
+        offsets[i + 1] += offsets[i];
+
+    rows.resize(offsets[gameCount]);
+    QList<quint32> cursor(offsets.cbegin(), offsets.cend() - 1);
+    for(quint32 row = 0; row < static_cast<quint32>(gameRows.size()); row++)
+        if(gameRows[row] != NO_ROW)
+            rows[cursor[gameRows[row]]++] = row;
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Private:
+QSqlError Snapshot::load(QSqlDatabase& database)
+{
+    // Read all tables within one transaction so that they agree with each other
+    if(!database.transaction())
+        return database.lastError();
+    QScopeGuard transactionGuard([&database](){ database.commit(); });
+
+    // Only needed while loading
+    QHash<QString, StringId> interned;
+
+    QSqlError loadError;
+    if((loadError = loadGames(database, interned)).isValid() ||
+       (loadError = loadAddApps(database, interned)).isValid() ||
+       (loadError = loadGameData(database, interned)).isValid())
+        return loadError;
+
+    // Group children under their parent
+    quint32 games = gameCount();
+    groupByGame(mAddAppOffsets, mAddAppsByGame, mAddApps.parentRow, games);
+    groupByGame(mGameDataOffsets, mGameDataByGame, mGameData.gameRow, games);
+
+    mStrings.squeeze();
+    return QSqlError();
+}
+
+QSqlError Snapshot::loadGames(QSqlDatabase& database, QHash<QString, StringId>& interned)
+{
+    using T = Db::Table_Game;
+
+    QSqlQuery countQuery(u"SELECT COUNT(1) FROM "_s + T::NAME, database);
+    if(countQuery.lastError().isValid())
+        return countQuery.lastError();
+    qsizetype rows = countQuery.next() ? countQuery.value(0).toLongLong() : 0;
+
+    QSqlQuery gameQuery(database);
+    gameQuery.setForwardOnly(true);
+    if(!gameQuery.exec(u"SELECT `"_s + T::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + T::NAME))
+        return gameQuery.lastError();
+
+    GameColumns& c = mGames;
+    for(QList<StringId>* col : {&c.title, &c.series, &c.developer, &c.publisher, &c.playMode, &c.statusText, &c.notes, &c.source, &c.appPath,
+                                 &c.launchCommand, &c.releaseDate, &c.version, &c.originalDescription, &c.language, &c.orderTitle, &c.libraryText,
+                                 &c.platformName, &c.ruffleSupport})
+        col->reserve(rows);
+    c.id.reserve(rows);
+    c.parentId.reserve(rows);
+    c.dateAdded.reserve(rows);
+    c.dateModified.reserve(rows);
+    c.broken.reserve(rows);
+    c.status.reserve(rows);
+    c.library.reserve(rows);
+    mGameIndex.reserve(rows);
+
+    while(gameQuery.next())
+    {
+        auto s = [&](T::Ordinal column){ return gameQuery.value(column).toString(); };
+        auto i = [&](T::Ordinal column){ return RecordCodec::intern(mStrings, interned, s(column)); };
+        auto sl = [&](T::Ordinal column){ return RecordCodec::intern(mStrings, interned, Db::singleLine(s(column))); };
+
+        QString status = s(T::ORD_STATUS);
+        QString library = s(T::ORD_LIBRARY);
+        QUuid id(s(T::ORD_ID));
+
+        mGameIndex.insert(id, c.id.size());
+        c.id.append(id);
+        c.parentId.append(QUuid(s(T::ORD_PARENT_ID)));
+        c.title.append(sl(T::ORD_TITLE));
+        c.series.append(sl(T::ORD_SERIES));
+        c.developer.append(sl(T::ORD_DEVELOPER));
+        c.publisher.append(sl(T::ORD_PUBLISHER));
+        c.dateAdded.append(RecordCodec::toEpoch(QDateTime::fromString(s(T::ORD_DATE_ADDED), Qt::ISODateWithMs)));
+        c.dateModified.append(RecordCodec::toEpoch(QDateTime::fromString(s(T::ORD_DATE_MODIFIED), Qt::ISODateWithMs)));
+        c.broken.append(gameQuery.value(T::ORD_BROKEN).toInt() != 0);
+        c.playMode.append(i(T::ORD_PLAY_MODE));
+        c.status.append(RecordCodec::parseStatus(status));
+        c.statusText.append(RecordCodec::intern(mStrings, interned, status));
+        c.notes.append(i(T::ORD_NOTES));
+        c.source.append(sl(T::ORD_SOURCE));
+        c.appPath.append(i(T::ORD_APP_PATH));
+        c.launchCommand.append(i(T::ORD_LAUNCH_COMMAND));
+        c.releaseDate.append(i(T::ORD_RELEASE_DATE));
+        c.version.append(sl(T::ORD_VERSION));
+        c.originalDescription.append(i(T::ORD_ORIGINAL_DESC));
+        c.language.append(sl(T::ORD_LANGUAGE));
+        c.orderTitle.append(sl(T::ORD_ORDER_TITLE));
+        c.library.append(RecordCodec::parseLibrary(library));
+        c.libraryText.append(RecordCodec::intern(mStrings, interned, library));
+        c.platformName.append(i(T::ORD_PLATFORM_NAME));
+        c.ruffleSupport.append(i(T::ORD_RUFFLE_SUPPORT));
+    }
+
+    return gameQuery.lastError();
+}
+
+QSqlError Snapshot::loadAddApps(QSqlDatabase& database, QHash<QString, StringId>& interned)
+{
+    using T = Db::Table_Add_App;
+
+    QSqlQuery addAppQuery(database);
+    addAppQuery.setForwardOnly(true);
+    if(!addAppQuery.exec(u"SELECT `"_s + T::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + T::NAME))
+        return addAppQuery.lastError();
+
+    AddAppColumns& c = mAddApps;
+    while(addAppQuery.next())
+    {
+        auto s = [&](T::Ordinal column){ return addAppQuery.value(column).toString(); };
+
+        QUuid id(s(T::ORD_ID));
+        QUuid parentId(s(T::ORD_PARENT_ID));
+
+        mAddAppIndex.insert(id, c.id.size());
+        c.id.append(id);
+        c.parentId.append(parentId);
+        c.parentRow.append(findGame(parentId));
+        c.appPath.append(RecordCodec::intern(mStrings, interned, s(T::ORD_APP_PATH)));
+        c.autorunBefore.append(addAppQuery.value(T::ORD_AUTORUN).toInt() != 0);
+        c.launchCommand.append(RecordCodec::intern(mStrings, interned, s(T::ORD_LAUNCH_COMMAND)));
+        c.name.append(RecordCodec::intern(mStrings, interned, Db::singleLine(s(T::ORD_NAME))));
+        c.waitExit.append(addAppQuery.value(T::ORD_WAIT_EXIT).toInt() != 0);
+    }
+
+    return addAppQuery.lastError();
+}
+
+QSqlError Snapshot::loadGameData(QSqlDatabase& database, QHash<QString, StringId>& interned)
+{
+    using T = Db::Table_Game_Data;
+
+    QSqlQuery dataQuery(database);
+    dataQuery.setForwardOnly(true);
+    if(!dataQuery.exec(u"SELECT `"_s + T::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + T::NAME))
+        return dataQuery.lastError();
+
+    GameDataColumns& c = mGameData;
+    while(dataQuery.next())
+    {
+        auto s = [&](T::Ordinal column){ return dataQuery.value(column).toString(); };
+
+        QUuid gameId(s(T::ORD_GAME_ID));
+
+        c.id.append(dataQuery.value(T::ORD_ID).toUInt());
+        c.gameId.append(gameId);
+        c.gameRow.append(findGame(gameId));
+        c.title.append(RecordCodec::intern(mStrings, interned, s(T::ORD_TITLE)));
+        // The builder handles the fractional seconds found in this column
+        c.dateAdded.append(RecordCodec::toEpoch(GameData::Builder().wDateAdded(s(T::ORD_DATE_ADDED)).build().dateAdded()));
+        c.sha256.append(RecordCodec::intern(mStrings, interned, s(T::ORD_SHA256)));
+        c.crc32.append(dataQuery.value(T::ORD_CRC32).toUInt());
+        c.presentOnDisk.append(dataQuery.value(T::ORD_PRES_ON_DISK).toInt() != 0);
+        c.path.append(RecordCodec::intern(mStrings, interned, s(T::ORD_PATH)));
+        c.size.append(dataQuery.value(T::ORD_SIZE).toUInt());
+        c.parameters.append(RecordCodec::intern(mStrings, interned, s(T::ORD_PARAM)));
+        c.appPath.append(RecordCodec::intern(mStrings, interned, s(T::ORD_APP_PATH)));
+        c.launchCommand.append(RecordCodec::intern(mStrings, interned, s(T::ORD_LAUNCH_COMMAND)));
+    }
+
+    return dataQuery.lastError();
+}
+
+//Public:
+quint32 Snapshot::gameCount() const { return mGames.id.size(); }
+quint32 Snapshot::addAppCount() const { return mAddApps.id.size(); }
+quint32 Snapshot::gameDataCount() const { return mGameData.id.size(); }
+const Snapshot::GameColumns& Snapshot::games() const { return mGames; }
+const Snapshot::AddAppColumns& Snapshot::addApps() const { return mAddApps; }
+const Snapshot::GameDataColumns& Snapshot::gameData() const { return mGameData; }
+const QString& Snapshot::string(StringId id) const { return mStrings.at(id); }
+
+quint32 Snapshot::findGame(const QUuid& id) const { return mGameIndex.value(id, NO_ROW); }
+quint32 Snapshot::findAddApp(const QUuid& id) const { return mAddAppIndex.value(id, NO_ROW); }
+
+std::span<const quint32> Snapshot::addAppRows(quint32 gameRow) const
+{
+    Q_ASSERT(gameRow < gameCount());
+    return std::span<const quint32>(mAddAppsByGame.constData() + mAddAppOffsets[gameRow], mAddAppOffsets[gameRow + 1] - mAddAppOffsets[gameRow]);
+}
+
+std::span<const quint32> Snapshot::gameDataRows(quint32 gameRow) const
+{
+    Q_ASSERT(gameRow < gameCount());
+    return std::span<const quint32>(mGameDataByGame.constData() + mGameDataOffsets[gameRow], mGameDataOffsets[gameRow + 1] - mGameDataOffsets[gameRow]);
+}
+
+Game Snapshot::game(quint32 row) const
+{
+    Q_ASSERT(row < gameCount());
+    const GameColumns& c = mGames;
+
+    Game::Builder fpGb;
+    fpGb.wId(c.id[row]);
+    fpGb.wTitle(string(c.title[row]));
+    fpGb.wSeries(string(c.series[row]));
+    fpGb.wDeveloper(string(c.developer[row]));
+    fpGb.wPublisher(string(c.publisher[row]));
+    fpGb.wDateAdded(fromEpoch(c.dateAdded[row]));
+    fpGb.wDateModified(fromEpoch(c.dateModified[row]));
+    fpGb.wBroken(c.broken[row]);
+    fpGb.wPlayMode(string(c.playMode[row]));
+    fpGb.wStatus(string(c.statusText[row]));
+    fpGb.wNotes(string(c.notes[row]));
+    fpGb.wSource(string(c.source[row]));
+    fpGb.wAppPath(string(c.appPath[row]));
+    fpGb.wLaunchCommand(string(c.launchCommand[row]));
+    fpGb.wReleaseDate(string(c.releaseDate[row]));
+    fpGb.wVersion(string(c.version[row]));
+    fpGb.wOriginalDescription(string(c.originalDescription[row]));
+    fpGb.wLanguage(string(c.language[row]));
+    fpGb.wOrderTitle(string(c.orderTitle[row]));
+    fpGb.wLibrary(string(c.libraryText[row]));
+    fpGb.wPlatformName(string(c.platformName[row]));
+    fpGb.wRuffleSupport(string(c.ruffleSupport[row]));
+
+    return fpGb.build();
+}
+
+AddApp Snapshot::addApp(quint32 row) const
+{
+    Q_ASSERT(row < addAppCount());
+    const AddAppColumns& c = mAddApps;
+
+    AddApp::Builder fpAab;
+    fpAab.wId(c.id[row].toString(QUuid::WithoutBraces));
+    fpAab.wAppPath(string(c.appPath[row]));
+    fpAab.wAutorunBefore(c.autorunBefore[row]);
+    fpAab.wLaunchCommand(string(c.launchCommand[row]));
+    fpAab.wName(string(c.name[row]));
+    fpAab.wWaitExit(c.waitExit[row]);
+    fpAab.wParentId(c.parentId[row].toString(QUuid::WithoutBraces));
+
+    return fpAab.build();
+}
+
+GameData Snapshot::gameData(quint32 row) const
+{
+    Q_ASSERT(row < gameDataCount());
+    const GameDataColumns& c = mGameData;
+
+    GameData::Builder fpGdb;
+    fpGdb.wId(c.id[row]);
+    fpGdb.wGameId(c.gameId[row].toString(QUuid::WithoutBraces));
+    fpGdb.wTitle(string(c.title[row]));
+    fpGdb.wDateAdded(fromEpoch(c.dateAdded[row]));
+    fpGdb.wSha256(string(c.sha256[row]));
+    fpGdb.wCrc32(c.crc32[row]);
+    fpGdb.wPresentOnDisk(c.presentOnDisk[row]);
+    fpGdb.wPath(string(c.path[row]));
+    fpGdb.wSize(c.size[row]);
+    fpGdb.wRawParameters(string(c.parameters[row]));
+    fpGdb.wAppPath(string(c.appPath[row]));
+    fpGdb.wLaunchCommand(string(c.launchCommand[row]));
+
+    return fpGdb.build();
+}
+
+}
@@ -0,0 +1,62 @@
+// Unit Includes
+#include "fp-stringpool.h"
+
+namespace Fp
+{
+
+//===============================================================================================================
+// StringPool
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Private:
+StringPool::StringPool() {}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Public:
+StringPool& StringPool::instance()
+{
+    static StringPool pool;
+    return pool;
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+QString StringPool::intern(const QString& str)
+{
+    if(str.isEmpty())
+        return str;
+
+    Shard& shard = mShards[qHash(str) % SHARD_COUNT];
+
+    // Nearly every call finds its value, so only take the write lock to add one
+    {
+        QReadLocker readLocker(&shard.lock);
+        if(auto itr = shard.strings.constFind(str); itr != shard.strings.cend())
+            return *itr;
+    }
+
+    QWriteLocker writeLocker(&shard.lock);
+    if(auto itr = shard.strings.constFind(str); itr != shard.strings.cend())
+        return *itr; // Added meanwhile
+
+    // Trim spare capacity, the pooled copy lives for the rest of the process
+    QString pooled = str;
+    pooled.squeeze();
+    shard.strings.insert(pooled);
+    return pooled;
+}
+
+qsizetype StringPool::size()
+{
+    qsizetype total = 0;
+    for(Shard& shard : mShards)
+    {
+        QReadLocker readLocker(&shard.lock);
+        total += shard.strings.size();
+    }
+
+    return total;
+}
+
+}
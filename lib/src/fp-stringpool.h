@@ -0,0 +1,57 @@
+#ifndef FLASHPOINT_STRINGPOOL_H
+#define FLASHPOINT_STRINGPOOL_H
+
+// Standard Library Includes
+#include <array>
+
+// Qt Includes
+#include <QSet>
+#include <QString>
+#include <QReadWriteLock>
+
+namespace Fp
+{
+
+/* Process wide pool of string values that repeat across many items, such as platform names or developers. Interning
+ * a value returns the pooled copy of it, so every holder shares one buffer instead of each holding its own, and equal
+ * values can be told apart by that buffer alone (see Atom).
+ *
+ * Values are never released, and every value is pooled no matter how many there are since atoms of a value that was
+ * passed through would compare unequal. Only fields whose values repeat across games should be interned; the largest,
+ * developer and publisher, have tens of thousands of values for a library of a few hundred thousand games.
+ */
+class StringPool
+{
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static constexpr int SHARD_COUNT = 16; // Spreads lock contention between builders on different threads
+
+//-Structs-----------------------------------------------------------------------------------------------------
+private:
+    struct Shard
+    {
+        QReadWriteLock lock;
+        QSet<QString> strings;
+    };
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    std::array<Shard, SHARD_COUNT> mShards;
+
+//-Constructor-------------------------------------------------------------------------------------------------
+private:
+    StringPool();
+
+//-Class Functions--------------------------------------------------------------------------------------------
+public:
+    static StringPool& instance();
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+public:
+    QString intern(const QString& str);
+    qsizetype size();
+};
+
+}
+
+#endif // FLASHPOINT_STRINGPOOL_H
@@ -0,0 +1,149 @@
+// Unit Includes
+#include "fp/fp-tagdirectory.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <numeric>
+
+namespace Fp
+{
+
+//===============================================================================================================
+// TagDirectory
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+TagDirectory::TagDirectory() {}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Private:
+void TagDirectory::addCategory(int id, const QString& name, const QColor& color)
+{
+    mCategoryIndices.insert(id, mCategories.size());
+    mCategories.append({.id = id, .name = name, .color = color, .firstTag = 0, .tagCount = 0});
+}
+
+bool TagDirectory::addTag(int id, const QString& primaryAlias, int categoryId)
+{
+    auto cItr = mCategoryIndices.constFind(categoryId);
+    if(cItr == mCategoryIndices.constEnd())
+        return false;
+
+    // Shares the category's copy of the name
+    mTags.append({.id = id, .primaryAlias = primaryAlias, .category = mCategories.at(*cItr).name});
+    mPendingCategories.append(*cItr);
+    return true;
+}
+
+void TagDirectory::seal()
+{
+    // Order categories by ID
+    QList<quint32> categoryOrder(mCategories.size());
+    std::iota(categoryOrder.begin(), categoryOrder.end(), 0);
+    std::sort(categoryOrder.begin(), categoryOrder.end(), [this](quint32 a, quint32 b){
+        return mCategories.at(a).id < mCategories.at(b).id;
+    });
+
+    QList<quint32> categoryRank(mCategories.size());
+    for(qsizetype r = 0; r < categoryOrder.size(); r++)
+        categoryRank[categoryOrder.at(r)] = r;
+
+    // Group tags by category, by ID within each
+    QList<quint32> tagOrder(mTags.size());
+    std::iota(tagOrder.begin(), tagOrder.end(), 0);
+    std::sort(tagOrder.begin(), tagOrder.end(), [&](quint32 a, quint32 b){
+        quint32 rankA = categoryRank.at(mPendingCategories.at(a));
+        quint32 rankB = categoryRank.at(mPendingCategories.at(b));
+        return rankA != rankB ? rankA < rankB : mTags.at(a).id < mTags.at(b).id;
+    });
+
+    // Lay out the final arrays and their lookups
+    QList<Category> categories;
+    categories.reserve(mCategories.size());
+    mCategoryIndices = {};
+    mCategoryIndices.reserve(mCategories.size());
+    for(quint32 c : std::as_const(categoryOrder))
+    {
+        mCategoryIndices.insert(mCategories.at(c).id, categories.size());
+        categories.append(mCategories.at(c));
+    }
+
+    QList<Db::Tag> tags;
+    tags.reserve(mTags.size());
+    mTagHandles = {};
+    mTagHandles.reserve(mTags.size());
+    for(quint32 t : std::as_const(tagOrder))
+    {
+        Category& category = categories[categoryRank.at(mPendingCategories.at(t))];
+        if(category.tagCount++ == 0)
+            category.firstTag = tags.size();
+
+        mTagHandles.insert(mTags.at(t).id, tags.size());
+        tags.append(std::move(mTags[t]));
+    }
+
+    // Categories without tags point at where theirs would be
+    Handle next = 0;
+    for(Category& category : categories)
+    {
+        if(category.tagCount == 0)
+            category.firstTag = next;
+        next = category.firstTag + category.tagCount;
+    }
+
+    mCategories = std::move(categories);
+    mTags = std::move(tags);
+    mPendingCategories = {};
+}
+
+//Public:
+bool TagDirectory::isEmpty() const { return mCategories.isEmpty(); }
+qsizetype TagDirectory::tagCount() const { return mTags.size(); }
+qsizetype TagDirectory::categoryCount() const { return mCategories.size(); }
+
+std::span<const Db::Tag> TagDirectory::tags() const { return {mTags.constData(), static_cast<size_t>(mTags.size())}; }
+
+std::span<const Db::Tag> TagDirectory::tags(const Category& category) const
+{
+    return tags().subspan(category.firstTag, category.tagCount);
+}
+
+std::span<const TagDirectory::Category> TagDirectory::categories() const
+{
+    return {mCategories.constData(), static_cast<size_t>(mCategories.size())};
+}
+
+TagDirectory::Handle TagDirectory::handle(int tagId) const { return mTagHandles.value(tagId, NO_TAG); }
+const Db::Tag& TagDirectory::tagAt(Handle handle) const { return mTags.at(handle); }
+
+const Db::Tag* TagDirectory::findTag(int tagId) const
+{
+    Handle h = handle(tagId);
+    return h != NO_TAG ? &mTags.at(h) : nullptr;
+}
+
+const TagDirectory::Category* TagDirectory::findCategory(int categoryId) const
+{
+    auto itr = mCategoryIndices.constFind(categoryId);
+    return itr != mCategoryIndices.constEnd() ? &mCategories.at(*itr) : nullptr;
+}
+
+QMap<int, Db::TagCategory> TagDirectory::toMap() const
+{
+    // The nested layout from before the directory was flattened. It's implicitly shared, so handing it out is cheap
+    std::call_once(mMapBuilt, [this]{
+        for(const Category& category : mCategories)
+        {
+            Db::TagCategory& tc = mMap[category.id];
+            tc.name = category.name;
+            tc.color = category.color;
+            for(const Db::Tag& tag : tags(category))
+                tc.tags.insert(tag.id, tag);
+        }
+    });
+
+    return mMap;
+}
+
+}
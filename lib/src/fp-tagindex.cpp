@@ -0,0 +1,562 @@
+// Unit Includes
+#include "fp/fp-tagindex.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <bit>
+
+namespace Fp
+{
+
+//===============================================================================================================
+// GameSet::Container
+//===============================================================================================================
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+bool GameSet::Container::isBitmap() const { return !bitmap.isEmpty(); }
+
+bool GameSet::Container::contains(quint16 low) const
+{
+    if(isBitmap())
+        return (bitmap[low >> 6] >> (low & 63)) & 1;
+    else
+        return std::binary_search(array.cbegin(), array.cend(), low);
+}
+
+void GameSet::Container::toBitmap()
+{
+    if(isBitmap())
+        return;
+
+    bitmap.fill(0, BITMAP_WORDS);
+    for(quint16 low : std::as_const(array))
+        bitmap[low >> 6] |= quint64(1) << (low & 63);
+    array = {};
+}
+
+void GameSet::Container::normalize()
+{
+    if(!isBitmap())
+    {
+        cardinality = array.size();
+        return;
+    }
+
+    cardinality = 0;
+    for(quint64 word : std::as_const(bitmap))
+        cardinality += std::popcount(word);
+
+    // Fall back to an array when sparse enough again
+    if(cardinality <= ARRAY_LIMIT)
+    {
+        array.reserve(cardinality);
+        for(int i = 0; i < BITMAP_WORDS; i++)
+        {
+            for(quint64 word = bitmap[i]; word; word &= word - 1)
+                array.append(static_cast<quint16>(i * 64 + std::countr_zero(word)));
+        }
+        bitmap = {};
+    }
+}
+
+//===============================================================================================================
+// GameSet
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Public:
+GameSet::GameSet() {}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Private:
+GameSet::Container GameSet::intersect(const Container& a, const Container& b)
+{
+    Container out{a.key, 0, {}, {}};
+
+    if(!a.isBitmap() && !b.isBitmap())
+        std::set_intersection(a.array.cbegin(), a.array.cend(), b.array.cbegin(), b.array.cend(), std::back_inserter(out.array));
+    else if(!a.isBitmap() || !b.isBitmap())
+    {
+        const Container& sparse = a.isBitmap() ? b : a;
+        const Container& dense = a.isBitmap() ? a : b;
+        for(quint16 low : sparse.array)
+            if(dense.contains(low))
+                out.array.append(low);
+    }
+    else
+    {
+        out.bitmap.resize(BITMAP_WORDS);
+        for(int i = 0; i < BITMAP_WORDS; i++)
+            out.bitmap[i] = a.bitmap[i] & b.bitmap[i];
+    }
+
+    out.normalize();
+    return out;
+}
+
+GameSet::Container GameSet::unite(const Container& a, const Container& b)
+{
+    Container out{a.key, 0, {}, {}};
+
+    if(!a.isBitmap() && !b.isBitmap() && a.cardinality + b.cardinality <= ARRAY_LIMIT)
+        std::set_union(a.array.cbegin(), a.array.cend(), b.array.cbegin(), b.array.cend(), std::back_inserter(out.array));
+    else
+    {
+        out.array = a.array;
+        out.bitmap = a.bitmap;
+        out.toBitmap();
+
+        if(b.isBitmap())
+        {
+            for(int i = 0; i < BITMAP_WORDS; i++)
+                out.bitmap[i] |= b.bitmap[i];
+        }
+        else
+        {
+            for(quint16 low : b.array)
+                out.bitmap[low >> 6] |= quint64(1) << (low & 63);
+        }
+    }
+
+    out.normalize();
+    return out;
+}
+
+GameSet::Container GameSet::subtract(const Container& a, const Container& b)
+{
+    Container out{a.key, 0, {}, {}};
+
+    if(!a.isBitmap())
+    {
+        for(quint16 low : a.array)
+            if(!b.contains(low))
+                out.array.append(low);
+    }
+    else
+    {
+        out.bitmap = a.bitmap;
+        if(b.isBitmap())
+        {
+            for(int i = 0; i < BITMAP_WORDS; i++)
+                out.bitmap[i] &= ~b.bitmap[i];
+        }
+        else
+        {
+            for(quint16 low : b.array)
+                out.bitmap[low >> 6] &= ~(quint64(1) << (low & 63));
+        }
+    }
+
+    out.normalize();
+    return out;
+}
+
+//Public:
+GameSet GameSet::fromSorted(const QList<quint32>& ordinals)
+{
+    GameSet set;
+
+    for(quint32 ordinal : ordinals)
+    {
+        quint16 key = ordinal >> 16;
+        if(set.mContainers.isEmpty() || set.mContainers.constLast().key != key)
+            set.mContainers.append(Container{key, 0, {}, {}});
+
+        Container& c = set.mContainers.last();
+        Q_ASSERT(c.array.isEmpty() || c.array.constLast() < static_cast<quint16>(ordinal));
+        c.array.append(static_cast<quint16>(ordinal));
+    }
+
+    for(Container& c : set.mContainers)
+    {
+        if(c.array.size() > ARRAY_LIMIT)
+            c.toBitmap();
+        c.normalize();
+    }
+
+    return set;
+}
+
+GameSet GameSet::range(quint32 count)
+{
+    GameSet set;
+
+    for(quint64 start = 0; start < count; start += 0x10000)
+    {
+        Container c{static_cast<quint16>(start >> 16), 0, {}, {}};
+        quint32 size = static_cast<quint32>(std::min<quint64>(count - start, 0x10000));
+
+        c.bitmap.fill(0, BITMAP_WORDS);
+        for(quint32 i = 0; i < size / 64; i++)
+            c.bitmap[i] = ~quint64(0);
+        if(size % 64)
+            c.bitmap[size / 64] = (quint64(1) << (size % 64)) - 1;
+
+        c.normalize();
+        set.mContainers.append(std::move(c));
+    }
+
+    return set;
+}
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Public:
+bool GameSet::isEmpty() const { return mContainers.isEmpty(); }
+
+qsizetype GameSet::cardinality() const
+{
+    qsizetype count = 0;
+    for(const Container& c : mContainers)
+        count += c.cardinality;
+    return count;
+}
+
+bool GameSet::contains(quint32 ordinal) const
+{
+    quint16 key = ordinal >> 16;
+    auto itr = std::lower_bound(mContainers.cbegin(), mContainers.cend(), key, [](const Container& c, quint16 k){ return c.key < k; });
+    return itr != mContainers.cend() && itr->key == key && itr->contains(static_cast<quint16>(ordinal));
+}
+
+QList<quint32> GameSet::toList() const
+{
+    QList<quint32> ordinals;
+    ordinals.reserve(cardinality());
+
+    for(const Container& c : mContainers)
+    {
+        quint32 high = quint32(c.key) << 16;
+        if(c.isBitmap())
+        {
+            for(int i = 0; i < BITMAP_WORDS; i++)
+                for(quint64 word = c.bitmap[i]; word; word &= word - 1)
+                    ordinals.append(high | (i * 64 + std::countr_zero(word)));
+        }
+        else
+        {
+            for(quint16 low : c.array)
+                ordinals.append(high | low);
+        }
+    }
+
+    return ordinals;
+}
+
+GameSet GameSet::intersected(const GameSet& other) const
+{
+    GameSet out;
+    auto a = mContainers.cbegin(), b = other.mContainers.cbegin();
+    while(a != mContainers.cend() && b != other.mContainers.cend())
+    {
+        if(a->key < b->key)
+            a++;
+        else if(b->key < a->key)
+            b++;
+        else
+        {
+            Container c = intersect(*a++, *b++);
+            if(c.cardinality > 0)
+                out.mContainers.append(std::move(c));
+        }
+    }
+
+    return out;
+}
+
+GameSet GameSet::united(const GameSet& other) const
+{
+    GameSet out;
+    auto a = mContainers.cbegin(), b = other.mContainers.cbegin();
+    while(a != mContainers.cend() || b != other.mContainers.cend())
+    {
+        if(b == other.mContainers.cend() || (a != mContainers.cend() && a->key < b->key))
+            out.mContainers.append(*a++);
+        else if(a == mContainers.cend() || b->key < a->key)
+            out.mContainers.append(*b++);
+        else
+            out.mContainers.append(unite(*a++, *b++));
+    }
+
+    return out;
+}
+
+GameSet GameSet::subtracted(const GameSet& other) const
+{
+    GameSet out;
+    auto b = other.mContainers.cbegin();
+    for(const Container& a : mContainers)
+    {
+        while(b != other.mContainers.cend() && b->key < a.key)
+            b++;
+
+        if(b == other.mContainers.cend() || b->key != a.key)
+            out.mContainers.append(a);
+        else if(Container c = subtract(a, *b); c.cardinality > 0)
+            out.mContainers.append(std::move(c));
+    }
+
+    return out;
+}
+
+//-Operators-----------------------------------------------------------------------------------------------------
+//Public:
+GameSet GameSet::operator&(const GameSet& other) const { return intersected(other); }
+GameSet GameSet::operator|(const GameSet& other) const { return united(other); }
+GameSet GameSet::operator-(const GameSet& other) const { return subtracted(other); }
+
+//===============================================================================================================
+// TagIndex
+//===============================================================================================================
+
+//-Constructor------------------------------------------------------------------------------------------------
+//Private:
+TagIndex::TagIndex() {}
+
+//-Class Functions--------------------------------------------------------------------------------------------
+//Private:
+DbError TagIndex::tokenize(QList<Token>& tokens, const QString& expression)
+{
+    tokens.clear();
+
+    auto isDelimiter = [](QChar c){ return c.isSpace() || c == u'(' || c == u')' || c == u'"'; };
+
+    qsizetype i = 0;
+    while(i < expression.size())
+    {
+        QChar c = expression.at(i);
+        if(c.isSpace())
+            i++;
+        else if(c == u'(' || c == u')')
+        {
+            tokens.append({c == u'(' ? TokenType::Open : TokenType::Close, QString(c), i});
+            i++;
+        }
+        else if(c == u'"')
+        {
+            qsizetype close = expression.indexOf(u'"', i + 1);
+            if(close == -1)
+                return DbError(DbError::InvalidExpression, ERR_UNTERMINATED.arg(i));
+
+            tokens.append({TokenType::Quoted, expression.sliced(i + 1, close - i - 1), i});
+            i = close + 1;
+        }
+        else
+        {
+            qsizetype start = i;
+            while(i < expression.size() && !isDelimiter(expression.at(i)))
+                i++;
+
+            QString word = expression.sliced(start, i - start);
+            if(word == u"AND"_s)
+                tokens.append({TokenType::And, word, start});
+            else if(word == u"OR"_s)
+                tokens.append({TokenType::Or, word, start});
+            else if(word == u"NOT"_s)
+                tokens.append({TokenType::Not, word, start});
+            else
+                tokens.append({TokenType::Word, word, start});
+        }
+    }
+
+    tokens.append({TokenType::End, u"<end>"_s, expression.size()});
+    return DbError();
+}
+
+DbError TagIndex::unexpected(const Token& token) { return DbError(DbError::InvalidExpression, ERR_UNEXPECTED.arg(token.text, QString::number(token.position))); }
+
+//-Instance Functions------------------------------------------------------------------------------------------------
+//Private:
+void TagIndex::addGame(const QUuid& gameId)
+{
+    mOrdinals.insert(gameId, mGames.size());
+    mGames.append(gameId);
+}
+
+void TagIndex::addTag(const Db::Tag& tag)
+{
+    QString name = tag.primaryAlias.toLower();
+    if(!mTagNames.contains(name))
+        mTagNames.insert(name, tag.id);
+
+    // Known tags and categories evaluate to empty sets rather than being unknown
+    mPendingTags[tag.id];
+    mPendingCategories[tag.category.toLower()];
+}
+
+void TagIndex::addMembership(const QUuid& gameId, const Db::Tag& tag)
+{
+    auto itr = mOrdinals.constFind(gameId);
+    if(itr == mOrdinals.constEnd())
+        return;
+
+    mPendingTags[tag.id].append(*itr);
+    mPendingCategories[tag.category.toLower()].append(*itr);
+}
+
+void TagIndex::seal()
+{
+    auto toSet = [](QList<quint32>& ordinals){
+        std::sort(ordinals.begin(), ordinals.end());
+        ordinals.erase(std::unique(ordinals.begin(), ordinals.end()), ordinals.end());
+        return GameSet::fromSorted(ordinals);
+    };
+
+    for(auto [tagId, ordinals] : mPendingTags.asKeyValueRange())
+        mTagSets.insert(tagId, toSet(ordinals));
+    for(auto [category, ordinals] : mPendingCategories.asKeyValueRange())
+        mCategorySets.insert(category, toSet(ordinals));
+
+    mPendingTags.clear();
+    mPendingCategories.clear();
+}
+
+DbError TagIndex::parseOr(GameSet& result, const QList<Token>& tokens, qsizetype& pos) const
+{
+    if(DbError error = parseAnd(result, tokens, pos); error.isValid())
+        return error;
+
+    while(tokens[pos].type == TokenType::Or)
+    {
+        GameSet rhs;
+        if(DbError error = parseAnd(rhs, tokens, ++pos); error.isValid())
+            return error;
+        result = result | rhs;
+    }
+
+    return DbError();
+}
+
+DbError TagIndex::parseAnd(GameSet& result, const QList<Token>& tokens, qsizetype& pos) const
+{
+    if(DbError error = parseNot(result, tokens, pos); error.isValid())
+        return error;
+
+    while(tokens[pos].type == TokenType::And)
+    {
+        GameSet rhs;
+        if(DbError error = parseNot(rhs, tokens, ++pos); error.isValid())
+            return error;
+        result = result & rhs;
+    }
+
+    return DbError();
+}
+
+DbError TagIndex::parseNot(GameSet& result, const QList<Token>& tokens, qsizetype& pos) const
+{
+    if(tokens[pos].type != TokenType::Not)
+        return parseTerm(result, tokens, pos);
+
+    GameSet operand;
+    if(DbError error = parseNot(operand, tokens, ++pos); error.isValid())
+        return error;
+    result = allGames() - operand;
+
+    return DbError();
+}
+
+DbError TagIndex::parseTerm(GameSet& result, const QList<Token>& tokens, qsizetype& pos) const
+{
+    const Token& token = tokens[pos];
+
+    if(token.type == TokenType::Open)
+    {
+        if(DbError error = parseOr(result, tokens, ++pos); error.isValid())
+            return error;
+        if(tokens[pos].type != TokenType::Close)
+            return unexpected(tokens[pos]);
+
+        pos++;
+        return DbError();
+    }
+
+    // Adjacent words make up one name, so that most names don't need quotes
+    QStringList words;
+    bool isCategory = false;
+    if(token.type == TokenType::Word && token.text.startsWith(CATEGORY_PREFIX, Qt::CaseInsensitive))
+    {
+        isCategory = true;
+        if(QString rest = token.text.sliced(CATEGORY_PREFIX.size()); !rest.isEmpty())
+            words.append(rest);
+        pos++;
+    }
+
+    if(words.isEmpty() && tokens[pos].type == TokenType::Quoted)
+        words.append(tokens[pos++].text);
+    else
+    {
+        while(tokens[pos].type == TokenType::Word)
+            words.append(tokens[pos++].text);
+    }
+
+    if(words.isEmpty())
+        return unexpected(tokens[pos]);
+
+    QString name = words.join(u' ');
+    if(isCategory)
+    {
+        auto itr = mCategorySets.constFind(name.toLower());
+        if(itr == mCategorySets.constEnd())
+            return DbError(DbError::InvalidExpression, ERR_UNKNOWN_CATEGORY.arg(name));
+        result = *itr;
+    }
+    else
+    {
+        auto itr = mTagNames.constFind(name.toLower());
+        if(itr == mTagNames.constEnd())
+            return DbError(DbError::InvalidExpression, ERR_UNKNOWN_TAG.arg(name));
+        result = tag(*itr);
+    }
+
+    return DbError();
+}
+
+//Public:
+quint32 TagIndex::gameCount() const { return mGames.size(); }
+QUuid TagIndex::gameId(quint32 ordinal) const { return mGames.value(ordinal); }
+
+QList<QUuid> TagIndex::gameIds(const GameSet& set) const
+{
+    QList<QUuid> ids;
+    ids.reserve(set.cardinality());
+    for(quint32 ordinal : set.toList())
+        ids.append(mGames.at(ordinal));
+    return ids;
+}
+
+std::optional<quint32> TagIndex::ordinal(const QUuid& gameId) const
+{
+    auto itr = mOrdinals.constFind(gameId);
+    return itr != mOrdinals.constEnd() ? std::optional<quint32>(*itr) : std::nullopt;
+}
+
+GameSet TagIndex::allGames() const { return GameSet::range(mGames.size()); }
+GameSet TagIndex::tag(int tagId) const { return mTagSets.value(tagId); }
+GameSet TagIndex::category(const QString& name) const { return mCategorySets.value(name.toLower()); }
+
+DbError TagIndex::evaluate(GameSet& result, const QString& expression) const
+{
+    result = GameSet();
+
+    QList<Token> tokens;
+    if(DbError error = tokenize(tokens, expression); error.isValid())
+        return error;
+
+    qsizetype pos = 0;
+    if(DbError error = parseOr(result, tokens, pos); error.isValid())
+    {
+        result = GameSet();
+        return error;
+    }
+
+    if(tokens[pos].type != TokenType::End)
+    {
+        result = GameSet();
+        return unexpected(tokens[pos]);
+    }
+
+    return DbError();
+}
+
+}
@@ -0,0 +1,186 @@
+// Qt Includes
+#include <QtTest>
+
+// Project Includes
+#include "fp/fp-db.h"
+#include "fp/fp-flathash.h"
+#include "benchdata.h"
+
+using Db = Fp::Db;
+
+/* Compares FlatHash against QHash on the key sets libfp keys its lookup tables by: game IDs and tag IDs. Keys are read
+ * from the database at FP_BENCH_DATABASE when it's set, and otherwise generated at the default scale. Lookups are half
+ * hits and half misses, since ID filters and redirect checks mostly ask for keys that aren't there.
+ */
+class bench_FlatHash : public QObject
+{
+    Q_OBJECT
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QList<QUuid> mUuidKeys;
+    QList<QUuid> mUuidProbes;
+    QList<int> mIntKeys;
+    QList<int> mIntProbes;
+
+//-Class Functions------------------------------------------------------------------------------------------------------
+private:
+    template<typename Map, typename Key>
+    static Map build(const QList<Key>& keys)
+    {
+        Map map;
+        map.reserve(keys.size());
+        for(qsizetype i = 0; i < keys.size(); i++)
+            map.insert(keys.at(i), static_cast<int>(i));
+        return map;
+    }
+
+    template<typename Map, typename Key>
+    static qint64 lookup(const Map& map, const QList<Key>& probes)
+    {
+        qint64 sum = 0;
+        for(const Key& probe : probes)
+            sum += map.value(probe, -1);
+        return sum;
+    }
+
+    template<typename Key>
+    static QList<Key> interleave(const QList<Key>& hits, const QList<Key>& misses)
+    {
+        QList<Key> probes;
+        probes.reserve(hits.size() + misses.size());
+        for(qsizetype i = 0; i < std::max(hits.size(), misses.size()); i++)
+        {
+            if(i < hits.size())
+                probes.append(hits.at(i));
+            if(i < misses.size())
+                probes.append(misses.at(i));
+        }
+        return probes;
+    }
+
+    template<typename Key>
+    static void compareBuild(const QList<Key>& keys, bool flat)
+    {
+        if(flat)
+        {
+            Fp::FlatHash<Key, int> map;
+            QBENCHMARK { map = build<Fp::FlatHash<Key, int>>(keys); }
+        }
+        else
+        {
+            QHash<Key, int> map;
+            QBENCHMARK { map = build<QHash<Key, int>>(keys); }
+        }
+    }
+
+    template<typename Key>
+    static void compareLookup(const QList<Key>& keys, const QList<Key>& probes, bool flat)
+    {
+        qint64 sum = 0;
+        if(flat)
+        {
+            auto map = build<Fp::FlatHash<Key, int>>(keys);
+            QBENCHMARK { sum += lookup(map, probes); }
+        }
+        else
+        {
+            auto map = build<QHash<Key, int>>(keys);
+            QBENCHMARK { sum += lookup(map, probes); }
+        }
+        Q_UNUSED(sum);
+    }
+
+    static void addImplementations()
+    {
+        QTest::addColumn<bool>("flat");
+        QTest::newRow("QHash") << false;
+        QTest::newRow("FlatHash") << true;
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QRandomGenerator generator(0x7A5E);
+
+        if(QString path = BenchData::realDatabasePath(); !path.isEmpty())
+        {
+            QSqlDatabase database;
+            QSqlError openError = BenchData::open(database, path, u"bench_flathash"_s);
+            QVERIFY2(!openError.isValid(), qPrintable(openError.text()));
+
+            {
+                QSqlQuery query(database);
+                query.setForwardOnly(true);
+                QVERIFY(query.exec(u"SELECT `"_s + Db::Table_Game::COL_ID + u"` FROM "_s + Db::Table_Game::NAME));
+                while(query.next())
+                    mUuidKeys.append(QUuid(query.value(0).toString()));
+
+                QVERIFY(query.exec(u"SELECT `"_s + Db::Table_Tag::COL_ID + u"` FROM "_s + Db::Table_Tag::NAME));
+                while(query.next())
+                    mIntKeys.append(query.value(0).toInt());
+            }
+
+            QString connectionName = database.connectionName();
+            database.close();
+            database = QSqlDatabase();
+            QSqlDatabase::removeDatabase(connectionName);
+        }
+        else
+        {
+            for(int g = 0; g < BenchData::DEFAULT_SCALE.games; g++)
+                mUuidKeys.append(BenchData::syntheticId(generator));
+            for(int t = 1; t <= BenchData::DEFAULT_SCALE.tags; t++)
+                mIntKeys.append(t);
+        }
+        QVERIFY(!mUuidKeys.isEmpty() && !mIntKeys.isEmpty());
+
+        // As many misses as hits, random IDs won't collide with real ones and tag IDs only grow
+        QList<QUuid> uuidMisses;
+        for(qsizetype i = 0; i < mUuidKeys.size(); i++)
+            uuidMisses.append(BenchData::syntheticId(generator));
+        mUuidProbes = interleave(mUuidKeys, uuidMisses);
+
+        int maxTagId = *std::max_element(mIntKeys.cbegin(), mIntKeys.cend());
+        QList<int> intMisses;
+        for(qsizetype i = 0; i < mIntKeys.size(); i++)
+            intMisses.append(maxTagId + 1 + static_cast<int>(i));
+        mIntProbes = interleave(mIntKeys, intMisses);
+    }
+
+    void sameResult()
+    {
+        QCOMPARE(lookup(build<Fp::FlatHash<QUuid, int>>(mUuidKeys), mUuidProbes), lookup(build<QHash<QUuid, int>>(mUuidKeys), mUuidProbes));
+        QCOMPARE(lookup(build<Fp::FlatHash<int, int>>(mIntKeys), mIntProbes), lookup(build<QHash<int, int>>(mIntKeys), mIntProbes));
+    }
+
+    void uuidBuild_data() { addImplementations(); }
+    void uuidBuild()
+    {
+        QFETCH(bool, flat);
+        compareBuild(mUuidKeys, flat);
+    }
+
+    void uuidLookup_data() { addImplementations(); }
+    void uuidLookup()
+    {
+        QFETCH(bool, flat);
+        compareLookup(mUuidKeys, mUuidProbes, flat);
+    }
+
+    void intBuild_data() { addImplementations(); }
+    void intBuild()
+    {
+        QFETCH(bool, flat);
+        compareBuild(mIntKeys, flat);
+    }
+
+    void intLookup_data() { addImplementations(); }
+    void intLookup()
+    {
+        QFETCH(bool, flat);
+        compareLookup(mIntKeys, mIntProbes, flat);
+    }
+};
+
+QTEST_GUILESS_MAIN(bench_FlatHash)
+#include "bench_flathash.moc"
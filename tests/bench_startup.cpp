@@ -0,0 +1,84 @@
+// Qt Includes
+#include <QtTest>
+
+// Project Includes
+#include "fp/fp-install.h"
+
+using Db = Fp::Db;
+
+/* Measures time to first query, from opening the install at FP_BENCH_INSTALL through reading the first game ID of a
+ * query, the way a short-lived CLI invocation would. The rest of the install is read the same way in each case, so
+ * differences come from how Db metadata is loaded. Cached cases have their cache written before measuring.
+ */
+class bench_Startup : public QObject
+{
+    Q_OBJECT
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QString mInstallPath;
+    QTemporaryDir mDir;
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    void firstQuery(const Db::ConnectionProfile& profile, bool useMetadata)
+    {
+        Fp::Install install(mInstallPath, false, profile);
+        if(!install.isValid())
+            qFatal("The install at %s could not be opened", qPrintable(mInstallPath));
+
+        Db* db = install.database();
+        Db::QueryBuffer ids;
+        if(db->queryAllGameIds(ids, Db::LibraryFilter::Either).isValid() || !ids.next())
+            qFatal("No game IDs could be read");
+
+        // Waits for deferred metadata
+        if(useMetadata)
+        {
+            QStringList platforms;
+            if(db->platformNames(platforms).isValid())
+                qFatal("Platform names could not be read");
+        }
+    }
+
+private slots:
+    void initTestCase()
+    {
+        mInstallPath = qEnvironmentVariable("FP_BENCH_INSTALL");
+        if(mInstallPath.isEmpty())
+            QSKIP("Set FP_BENCH_INSTALL to the root of a Flashpoint install to run this benchmark.");
+        QVERIFY(mDir.isValid());
+    }
+
+    void timeToFirstQuery_data()
+    {
+        QTest::addColumn<bool>("cached");
+        QTest::addColumn<bool>("deferred");
+        QTest::addColumn<bool>("useMetadata");
+
+        QTest::newRow("eager") << false << false << false;
+        QTest::newRow("deferred") << false << true << false;
+        QTest::newRow("deferred, then metadata") << false << true << true;
+        QTest::newRow("cached") << true << false << false;
+        QTest::newRow("cached, then metadata") << true << false << true;
+    }
+
+    void timeToFirstQuery()
+    {
+        QFETCH(bool, cached);
+        QFETCH(bool, deferred);
+        QFETCH(bool, useMetadata);
+
+        Db::ConnectionProfile profile;
+        profile.deferMetadata = deferred;
+        if(cached)
+        {
+            profile.metadataCachePath = mDir.filePath(QString::fromLatin1(QTest::currentDataTag()) + u".cache"_s);
+            firstQuery(profile, false); // Writes the cache
+        }
+
+        QBENCHMARK { firstQuery(profile, useMetadata); }
+    }
+};
+
+QTEST_GUILESS_MAIN(bench_Startup)
+#include "bench_startup.moc"
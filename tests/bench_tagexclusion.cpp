@@ -0,0 +1,156 @@
+// Qt Includes
+#include <QtTest>
+
+// Project Includes
+#include "fp/fp-db.h"
+#include "benchdata.h"
+#include "testaccess.h"
+
+using Db = Fp::Db;
+
+/* Compares the two ways queryGamesByPlatform() has excluded games carrying given tags. Previously the IDs of all such
+ * games were pulled into a QSet and bound back as an ID set, which is reproduced here by hand. Now the game query checks
+ * each game with NOT EXISTS, which is measured through queryGamesByPlatform() itself on a Db over the same file. Both
+ * walk the full result, as callers do.
+ */
+class bench_TagExclusion : public QObject
+{
+    Q_OBJECT
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static constexpr int EXCLUDED_TAG_COUNT = 25; // The most common tags, as with the extreme filter
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QTemporaryDir mDir;
+    QSqlDatabase mDatabase;
+    std::unique_ptr<Db> mDb;
+    QString mPlatform;
+    QList<int> mExcludedTagIds;
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    QString gameCommand(const QString& exclusion) const
+    {
+        return u"SELECT `"_s + Db::Table_Game::COLUMN_LIST.join(u"`,`"_s) + u"` FROM "_s + Db::Table_Game::NAME + u" WHERE "_s +
+               Db::Table_Game::COL_PLATFORM_NAME + u" = :platform AND "_s + Db::Table_Game::COL_LIBRARY + u" = '"_s +
+               Db::Table_Game::ENTRY_GAME_LIBRARY + u"' AND "_s + exclusion;
+    }
+
+    QString tagIdList(const QString& separator) const
+    {
+        QStringList ids;
+        for(int id : mExcludedTagIds)
+            ids.append(QString::number(id));
+        return ids.join(separator);
+    }
+
+    template<typename Result>
+    int walk(Result& query)
+    {
+        // Read some values so that rows are actually decoded
+        int rows = 0;
+        qsizetype chars = 0;
+        while(query.next())
+        {
+            chars += query.value(Db::Table_Game::ORD_ID).toString().size() + query.value(Db::Table_Game::ORD_TITLE).toString().size();
+            rows++;
+        }
+        Q_UNUSED(chars);
+        return rows;
+    }
+
+    int materializedSet()
+    {
+        // Excluded games first, as the old makeGameFilter() did
+        QSqlQuery tagQuery(mDatabase);
+        tagQuery.setForwardOnly(true);
+        if(!tagQuery.exec(u"SELECT `"_s + Db::Table_Game_Tags_Tag::COL_GAME_ID + u"` FROM "_s + Db::Table_Game_Tags_Tag::NAME + u" WHERE "_s +
+                          Db::Table_Game_Tags_Tag::COL_TAG_ID + u" IN ("_s + tagIdList(u","_s) + u")"_s))
+            qFatal("%s", qPrintable(tagQuery.lastError().text()));
+
+        QSet<QUuid> excluded;
+        while(tagQuery.next())
+            excluded.insert(QUuid(tagQuery.value(0).toString()));
+
+        QStringList excludedJson;
+        for(const QUuid& id : std::as_const(excluded))
+            excludedJson.append(id.toString(QUuid::WithoutBraces));
+
+        QSqlQuery gameQuery(mDatabase);
+        gameQuery.setForwardOnly(true);
+        gameQuery.prepare(gameCommand(u"NOT "_s + Db::Table_Game::COL_ID + u" IN (SELECT value FROM json_each(:excludedIds))"_s));
+        gameQuery.bindValue(u":platform"_s, mPlatform);
+        gameQuery.bindValue(u":excludedIds"_s, u"[\""_s + excludedJson.join(u"\",\""_s) + u"\"]"_s);
+        if(!gameQuery.exec())
+            qFatal("%s", qPrintable(gameQuery.lastError().text()));
+
+        return walk(gameQuery);
+    }
+
+    int notExists()
+    {
+        Db::InclusionOptions options{.excludedTagIds = QSet<int>(mExcludedTagIds.cbegin(), mExcludedTagIds.cend())};
+        Db::QueryBuffer games;
+        if(Fp::DbError queryError = mDb->queryGamesByPlatform(games, {mPlatform}, options); queryError.isValid())
+            qFatal("%s", qPrintable(queryError.cause()));
+
+        return walk(games);
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QString path = BenchData::realDatabasePath();
+        if(path.isEmpty())
+        {
+            QVERIFY(mDir.isValid());
+            path = mDir.filePath(u"flashpoint.sqlite"_s);
+            QSqlError createError = BenchData::createSyntheticDatabase(path);
+            QVERIFY2(!createError.isValid(), qPrintable(createError.text()));
+        }
+
+        QSqlError openError = BenchData::open(mDatabase, path, u"bench_tagexclusion"_s);
+        QVERIFY2(!openError.isValid(), qPrintable(openError.text()));
+
+        mDb = Fp::TestAccess::makeDb(path);
+        QVERIFY2(mDb->isValid(), qPrintable(mDb->error().cause()));
+
+        // Largest platform, and the most used tags
+        QSqlQuery query(mDatabase);
+        QVERIFY(query.exec(u"SELECT "_s + Db::Table_Game::COL_PLATFORM_NAME + u" FROM "_s + Db::Table_Game::NAME + u" GROUP BY 1 ORDER BY COUNT(1) DESC LIMIT 1"_s));
+        QVERIFY(query.next());
+        mPlatform = query.value(0).toString();
+
+        QVERIFY(query.exec(u"SELECT "_s + Db::Table_Game_Tags_Tag::COL_TAG_ID + u" FROM "_s + Db::Table_Game_Tags_Tag::NAME +
+                           u" GROUP BY 1 ORDER BY COUNT(1) DESC LIMIT "_s + QString::number(EXCLUDED_TAG_COUNT)));
+        while(query.next())
+            mExcludedTagIds.append(query.value(0).toInt());
+        QVERIFY(!mExcludedTagIds.isEmpty());
+    }
+
+    void cleanupTestCase()
+    {
+        mDb.reset();
+
+        QString connectionName = mDatabase.connectionName();
+        mDatabase.close();
+        mDatabase = QSqlDatabase();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+
+    void sameResult() { QCOMPARE(notExists(), materializedSet()); }
+
+    void materializedSetBench()
+    {
+        QBENCHMARK { materializedSet(); }
+    }
+
+    void notExistsBench()
+    {
+        QBENCHMARK { notExists(); }
+    }
+};
+
+QTEST_GUILESS_MAIN(bench_TagExclusion)
+#include "bench_tagexclusion.moc"
@@ -0,0 +1,178 @@
+// Unit Includes
+#include "benchdata.h"
+
+// Project Includes
+#include "fp/fp-db.h"
+
+namespace BenchData
+{
+
+namespace
+{
+    using Db = Fp::Db;
+
+    QString createCommand(const QString& table, const QStringList& columns, const QString& constraints = {})
+    {
+        // Columns are left untyped, SQLite stores whatever is bound
+        return u"CREATE TABLE `"_s + table + u"` (`"_s + columns.join(u"`,`"_s) + u"`"_s +
+               (constraints.isEmpty() ? QString() : u","_s + constraints) + u")"_s;
+    }
+
+    QString insertCommand(const QString& table, const QStringList& columns)
+    {
+        return u"INSERT INTO `"_s + table + u"` (`"_s + columns.join(u"`,`"_s) + u"`) VALUES ("_s +
+               QStringList(columns.size(), u"?"_s).join(',') + u")"_s;
+    }
+
+    int skewed(QRandomGenerator& generator, int bound)
+    {
+        // Low values come up far more often, like popular tags and platforms do
+        return static_cast<int>((qint64(generator.bounded(bound)) * generator.bounded(bound)) / bound);
+    }
+}
+
+QString realDatabasePath() { return qEnvironmentVariable("FP_BENCH_DATABASE"); }
+
+QUuid syntheticId(QRandomGenerator& generator)
+{
+    quint32 parts[4];
+    generator.fillRange(parts);
+
+    // Version 4 layout, same as the IDs Flashpoint assigns
+    return QUuid(parts[0], parts[1] >> 16, (parts[1] & 0x0FFF) | 0x4000,
+                 0x80 | ((parts[2] >> 24) & 0x3F), parts[2] >> 16, parts[2] >> 8, parts[2],
+                 parts[3] >> 24, parts[3] >> 16, parts[3] >> 8, parts[3]);
+}
+
+QSqlError createSyntheticDatabase(const QString& path, const Scale& scale)
+{
+    QSqlDatabase database;
+    if(QSqlError openError = open(database, path, u"bench_create"_s); openError.isValid())
+        return openError;
+
+    QString connectionName = database.connectionName();
+    QScopeGuard removeGuard([&]{
+        database.close();
+        database = QSqlDatabase();
+        QSqlDatabase::removeDatabase(connectionName);
+    });
+
+    // Same indexes as the launcher's schema where lookups depend on them
+    const QStringList schema{
+        createCommand(Db::Table_Game::NAME, Db::Table_Game::COLUMN_LIST, u"PRIMARY KEY (`id`)"_s),
+        createCommand(Db::Table_Add_App::NAME, Db::Table_Add_App::COLUMN_LIST, u"PRIMARY KEY (`id`)"_s),
+        createCommand(Db::Table_Game_Data::NAME, Db::Table_Game_Data::COLUMN_LIST, u"PRIMARY KEY (`id`)"_s),
+        createCommand(Db::Table_Game_Tags_Tag::NAME, Db::Table_Game_Tags_Tag::COLUMN_LIST, u"PRIMARY KEY (`gameId`, `tagId`)"_s),
+        createCommand(Db::Table_Tag::NAME, Db::Table_Tag::COLUMN_LIST, u"PRIMARY KEY (`id`)"_s),
+        createCommand(Db::Table_Tag_Alias::NAME, Db::Table_Tag_Alias::COLUMN_LIST, u"PRIMARY KEY (`id`)"_s),
+        createCommand(Db::Table_Tag_Category::NAME, Db::Table_Tag_Category::COLUMN_LIST, u"PRIMARY KEY (`id`)"_s),
+        createCommand(Db::Table_Game_Redirect::NAME, Db::Table_Game_Redirect::COLUMN_LIST, u"PRIMARY KEY (`sourceId`)"_s),
+        u"CREATE INDEX `IDX_gameTags_gameId` ON `game_tags_tag` (`gameId`)"_s,
+        u"CREATE INDEX `IDX_gameTags_tagId` ON `game_tags_tag` (`tagId`)"_s,
+        u"CREATE INDEX `IDX_game_platformName` ON `game` (`platformName`)"_s,
+        u"CREATE INDEX `IDX_gameData_gameId` ON `game_data` (`gameId`)"_s
+    };
+
+    QSqlQuery query(database);
+    for(const QString& command : schema)
+        if(!query.exec(command))
+            return query.lastError();
+
+    if(!database.transaction())
+        return database.lastError();
+    QScopeGuard rollbackGuard([&database]{ database.rollback(); });
+
+    QRandomGenerator generator(0x1F1A5);
+
+    // Tags
+    static constexpr int CATEGORY_COUNT = 8;
+    QSqlQuery categoryInsert(database), aliasInsert(database), tagInsert(database);
+    categoryInsert.prepare(insertCommand(Db::Table_Tag_Category::NAME, Db::Table_Tag_Category::COLUMN_LIST));
+    aliasInsert.prepare(insertCommand(Db::Table_Tag_Alias::NAME, Db::Table_Tag_Alias::COLUMN_LIST));
+    tagInsert.prepare(insertCommand(Db::Table_Tag::NAME, Db::Table_Tag::COLUMN_LIST));
+
+    for(int c = 1; c <= CATEGORY_COUNT; c++)
+    {
+        categoryInsert.addBindValue(c);
+        categoryInsert.addBindValue(u"Category "_s + QString::number(c));
+        categoryInsert.addBindValue(u"#ffffff"_s);
+        if(!categoryInsert.exec())
+            return categoryInsert.lastError();
+    }
+
+    for(int t = 1; t <= scale.tags; t++)
+    {
+        aliasInsert.addBindValue(t);
+        aliasInsert.addBindValue(t);
+        aliasInsert.addBindValue(u"Tag "_s + QString::number(t));
+        tagInsert.addBindValue(t);
+        tagInsert.addBindValue(t);
+        tagInsert.addBindValue(1 + t % CATEGORY_COUNT);
+        if(!aliasInsert.exec())
+            return aliasInsert.lastError();
+        if(!tagInsert.exec())
+            return tagInsert.lastError();
+    }
+
+    // Games and their tags
+    QSqlQuery gameInsert(database), gameTagInsert(database);
+    gameInsert.prepare(insertCommand(Db::Table_Game::NAME, Db::Table_Game::COLUMN_LIST));
+    gameTagInsert.prepare(insertCommand(Db::Table_Game_Tags_Tag::NAME, Db::Table_Game_Tags_Tag::COLUMN_LIST));
+
+    for(int g = 0; g < scale.games; g++)
+    {
+        QString id = syntheticId(generator).toString(QUuid::WithoutBraces);
+        QVariantList values(Db::Table_Game::ORD_COUNT, u""_s);
+        values[Db::Table_Game::ORD_ID] = id;
+        values[Db::Table_Game::ORD_TITLE] = u"Game "_s + QString::number(g);
+        values[Db::Table_Game::ORD_DEVELOPER] = u"Developer "_s + QString::number(generator.bounded(scale.games / 4 + 1));
+        values[Db::Table_Game::ORD_PUBLISHER] = u"Publisher "_s + QString::number(generator.bounded(scale.games / 20 + 1));
+        values[Db::Table_Game::ORD_DATE_ADDED] = u"2019-01-01T00:00:00.000Z"_s;
+        values[Db::Table_Game::ORD_DATE_MODIFIED] = u"2023-01-01T00:00:00.000Z"_s;
+        values[Db::Table_Game::ORD_BROKEN] = 0;
+        values[Db::Table_Game::ORD_EXTREME] = 0;
+        values[Db::Table_Game::ORD_PLAY_MODE] = u"Single Player"_s;
+        values[Db::Table_Game::ORD_STATUS] = u"Playable"_s;
+        values[Db::Table_Game::ORD_LANGUAGE] = u"en"_s;
+        values[Db::Table_Game::ORD_LIBRARY] = generator.bounded(10) == 0 ? Db::Table_Game::ENTRY_ANIM_LIBRARY : Db::Table_Game::ENTRY_GAME_LIBRARY;
+        values[Db::Table_Game::ORD_PLATFORM_NAME] = u"Platform "_s + QString::number(skewed(generator, scale.platforms));
+
+        for(const QVariant& value : std::as_const(values))
+            gameInsert.addBindValue(value);
+        if(!gameInsert.exec())
+            return gameInsert.lastError();
+
+        QSet<int> tagIds;
+        while(tagIds.size() < std::min(scale.tagsPerGame, scale.tags))
+            tagIds.insert(1 + skewed(generator, scale.tags));
+
+        for(int tagId : std::as_const(tagIds))
+        {
+            gameTagInsert.addBindValue(id);
+            gameTagInsert.addBindValue(tagId);
+            if(!gameTagInsert.exec())
+                return gameTagInsert.lastError();
+        }
+    }
+
+    if(!database.commit())
+        return database.lastError();
+    rollbackGuard.dismiss();
+
+    return QSqlError();
+}
+
+QSqlError open(QSqlDatabase& database, const QString& path, const QString& connectionName)
+{
+    database = QSqlDatabase::addDatabase(u"QSQLITE"_s, connectionName);
+    database.setDatabaseName(path);
+    if(database.open())
+        return QSqlError();
+
+    QSqlError openError = database.lastError();
+    database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(connectionName);
+    return openError;
+}
+
+}
@@ -0,0 +1,35 @@
+#ifndef FLASHPOINT_BENCHDATA_H
+#define FLASHPOINT_BENCHDATA_H
+
+// Qt Includes
+#include <QtSql>
+#include <QRandomGenerator>
+
+using namespace Qt::Literals::StringLiterals;
+
+/* Data for benchmarks. Measurements are made against the database at FP_BENCH_DATABASE when it's set, so that they can be
+ * taken on a real library, and otherwise against a generated one that follows the layout of the Flashpoint tables they
+ * touch. Generated data is the same from run to run.
+ */
+namespace BenchData
+{
+
+struct Scale
+{
+    int games;
+    int tags;
+    int tagsPerGame;
+    int platforms;
+};
+
+// Roughly the size of a current Flashpoint library
+inline constexpr Scale DEFAULT_SCALE{.games = 150000, .tags = 4000, .tagsPerGame = 8, .platforms = 40};
+
+QString realDatabasePath();
+QUuid syntheticId(QRandomGenerator& generator);
+QSqlError createSyntheticDatabase(const QString& path, const Scale& scale = DEFAULT_SCALE);
+QSqlError open(QSqlDatabase& database, const QString& path, const QString& connectionName);
+
+}
+
+#endif // FLASHPOINT_BENCHDATA_H
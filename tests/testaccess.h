@@ -0,0 +1,52 @@
+#ifndef FLASHPOINT_TESTACCESS_H
+#define FLASHPOINT_TESTACCESS_H
+
+// Standard Library Includes
+#include <memory>
+
+// Qt Includes
+#include <QList>
+#include <QUuid>
+
+// Project Includes
+#include "fp/fp-tagindex.h"
+
+namespace Fp
+{
+
+/* Lets tests build library objects directly rather than through an install, i.e. a Db over a bare database file. The
+ * library only declares this class as a friend; it is defined here and nowhere else.
+ */
+class TestAccess
+{
+//-Class Functions--------------------------------------------------------------------------------------------
+public:
+    static std::unique_ptr<Db> makeDb(const QString& databasePath, const Db::ConnectionProfile& profile = {})
+    {
+        return std::make_unique<Db>(databasePath, profile, Db::Key());
+    }
+
+    static TagIndex makeTagIndex(const QList<QUuid>& gameIds, const QList<Db::Tag>& tags, const QList<std::pair<QUuid, int>>& gameTags)
+    {
+        TagIndex index;
+        for(const QUuid& gameId : gameIds)
+            index.addGame(gameId);
+
+        QHash<int, Db::Tag> tagsById;
+        for(const Db::Tag& tag : tags)
+        {
+            index.addTag(tag);
+            tagsById.insert(tag.id, tag);
+        }
+
+        for(const auto& [gameId, tagId] : gameTags)
+            index.addMembership(gameId, tagsById.value(tagId));
+
+        index.seal();
+        return index;
+    }
+};
+
+}
+
+#endif // FLASHPOINT_TESTACCESS_H
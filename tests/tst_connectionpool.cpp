@@ -0,0 +1,237 @@
+// Standard Library Includes
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Qt Includes
+#include <QtTest>
+
+// Project Includes
+#include "fp-connectionpool.h"
+
+using ConnectionPool = Fp::ConnectionPool;
+using PooledConnection = Fp::PooledConnection;
+
+/* Checks that pooled connections are only ever used by the thread that opened them, while the pool still caps how many
+ * are open across all threads and idle ones can be taken over by any thread. Workers are plain std::threads, like the
+ * ones a host application may use.
+ */
+class tst_ConnectionPool : public QObject
+{
+    Q_OBJECT
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static constexpr int THREAD_COUNT = 8;
+    static constexpr int ROUNDS = 50;
+    static inline const QString NAME_PREFIX = u"tst_connectionpool_"_s;
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    QTemporaryDir mDir;
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    std::shared_ptr<ConnectionPool> makePool(int maxSize, std::chrono::milliseconds idleTimeout = std::chrono::minutes(1))
+    {
+        QString path = mDir.filePath(u"pool.sqlite"_s);
+        auto opener = [path](PooledConnection& connection, const QString& connectionName){
+            connection.database = QSqlDatabase::addDatabase(u"QSQLITE"_s, connectionName);
+            connection.database.setDatabaseName(path);
+            if(connection.database.open())
+                return QSqlError();
+
+            QSqlError openError = connection.database.lastError();
+            connection.database = QSqlDatabase();
+            QSqlDatabase::removeDatabase(connectionName);
+            return openError;
+        };
+
+        return std::make_shared<ConnectionPool>(NAME_PREFIX, opener, maxSize, idleTimeout);
+    }
+
+    static int openConnectionCount()
+    {
+        int count = 0;
+        for(const QString& name : QSqlDatabase::connectionNames())
+            if(name.startsWith(NAME_PREFIX))
+                count++;
+        return count;
+    }
+
+    static bool ownedByCurrentThread(const PooledConnection& connection)
+    {
+        return connection.owner == std::this_thread::get_id() && connection.database.driver()->thread() == QThread::currentThread();
+    }
+
+    static bool useConnection(PooledConnection& connection)
+    {
+        QSqlQuery query(connection.database);
+        return query.exec(u"SELECT 1"_s) && query.next() && query.value(0).toInt() == 1;
+    }
+
+private slots:
+    void initTestCase() { QVERIFY(mDir.isValid()); }
+
+    void cleanup() { QCOMPARE(openConnectionCount(), 0); }
+
+    void sameThreadSharesLease()
+    {
+        auto pool = makePool(1);
+
+        std::shared_ptr<PooledConnection> outer, inner;
+        QVERIFY(!pool->acquire(outer).isValid());
+
+        // Would time out if a nested acquire had to wait for the outer one
+        QVERIFY(!pool->acquire(inner).isValid());
+        QCOMPARE(inner.get(), outer.get());
+        QCOMPARE(pool->size(), 1);
+
+        inner.reset();
+        outer.reset();
+        pool.reset();
+    }
+
+    void connectionsStayWithTheirThread()
+    {
+        auto pool = makePool(THREAD_COUNT);
+        std::atomic<int> failures = 0;
+
+        std::vector<std::thread> threads;
+        for(int t = 0; t < THREAD_COUNT; t++)
+        {
+            threads.emplace_back([&pool, &failures]{
+                const PooledConnection* first = nullptr;
+                for(int r = 0; r < ROUNDS; r++)
+                {
+                    std::shared_ptr<PooledConnection> connection;
+                    if(pool->acquire(connection).isValid() || !ownedByCurrentThread(*connection) || !useConnection(*connection) ||
+                       (first && connection.get() != first))
+                        failures++;
+                    first = connection.get();
+                }
+            });
+        }
+
+        for(std::thread& thread : threads)
+            thread.join();
+
+        QCOMPARE(failures.load(), 0);
+        QCOMPARE(pool->size(), 0); // Closed by their threads on exit
+        pool.reset();
+    }
+
+    void capIsEnforced()
+    {
+        static constexpr int CAP = 2;
+        auto pool = makePool(CAP);
+        std::atomic<int> failures = 0;
+        std::atomic<int> peak = 0;
+
+        std::vector<std::thread> threads;
+        for(int t = 0; t < THREAD_COUNT; t++)
+        {
+            threads.emplace_back([&]{
+                for(int r = 0; r < ROUNDS; r++)
+                {
+                    std::shared_ptr<PooledConnection> connection;
+                    if(pool->acquire(connection).isValid() || !ownedByCurrentThread(*connection) || !useConnection(*connection))
+                    {
+                        failures++;
+                        continue;
+                    }
+
+                    int size = pool->size();
+                    int seen = peak.load();
+                    while(size > seen && !peak.compare_exchange_weak(seen, size)) {}
+                }
+            });
+        }
+
+        for(std::thread& thread : threads)
+            thread.join();
+
+        QCOMPARE(failures.load(), 0);
+        QVERIFY(peak.load() <= CAP);
+        QCOMPARE(pool->size(), 0);
+        pool.reset();
+    }
+
+    void idleSlotTakenOver()
+    {
+        auto pool = makePool(1);
+        QSemaphore ownerIdle, ownerResume;
+        bool ownerUsed = false, ownerReacquired = false;
+
+        // The owner keeps running, but never calls into the pool while the main thread needs the only slot
+        std::thread owner([&]{
+            std::shared_ptr<PooledConnection> connection;
+            ownerUsed = !pool->acquire(connection).isValid() && useConnection(*connection);
+            connection.reset();
+            ownerIdle.release();
+
+            ownerResume.acquire();
+            ownerReacquired = !pool->acquire(connection).isValid() && ownedByCurrentThread(*connection) && useConnection(*connection);
+        });
+
+        ownerIdle.acquire();
+        QElapsedTimer waited;
+        waited.start();
+        std::shared_ptr<PooledConnection> connection;
+        bool acquired = !pool->acquire(connection).isValid();
+        qint64 waitTime = waited.elapsed();
+        bool used = acquired && ownedByCurrentThread(*connection) && useConnection(*connection);
+        int size = pool->size();
+        int open = openConnectionCount();
+        connection.reset();
+
+        ownerResume.release();
+        owner.join();
+
+        QVERIFY(ownerUsed);
+        QVERIFY(acquired);
+        QVERIFY(waitTime < 1000); // Would be the full acquire timeout if the slot had to be given up by its owner
+        QVERIFY(used);
+        QCOMPARE(size, 1);
+        QCOMPARE(open, 1);
+        QVERIFY(ownerReacquired);
+        pool.reset();
+    }
+
+    void idleConnectionsClose()
+    {
+        auto pool = makePool(2, std::chrono::milliseconds(0));
+
+        std::shared_ptr<PooledConnection> connection;
+        QVERIFY(!pool->acquire(connection).isValid());
+        connection.reset();
+        QCOMPARE(pool->size(), 1);
+
+        pool->closeIdle();
+        QCOMPARE(pool->size(), 0);
+        QCOMPARE(openConnectionCount(), 0);
+        pool.reset();
+    }
+
+    void poolOutlivedByLease()
+    {
+        auto pool = makePool(1);
+
+        std::shared_ptr<PooledConnection> connection;
+        QVERIFY(!pool->acquire(connection).isValid());
+        pool.reset();
+
+        // Still usable, and closed by this thread once something sweeps
+        QVERIFY(useConnection(*connection));
+        connection.reset();
+
+        auto other = makePool(1);
+        std::shared_ptr<PooledConnection> next;
+        QVERIFY(!other->acquire(next).isValid());
+        next.reset();
+        other->closeIdle();
+        other.reset();
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_ConnectionPool)
+#include "tst_connectionpool.moc"
@@ -0,0 +1,247 @@
+// Standard Library Includes
+#include <numeric>
+
+// Qt Includes
+#include <QtTest>
+
+// Project Includes
+#include "fp/fp-tagindex.h"
+#include "testaccess.h"
+
+using GameSet = Fp::GameSet;
+using TagIndex = Fp::TagIndex;
+using Db = Fp::Db;
+
+/* Checks GameSet operations against QSet on random ordinals, at sizes that keep containers as arrays, turn them into
+ * bitmaps, and spread them over several containers. Expressions are evaluated against a small fixed index where each
+ * case has a different answer depending on how it is parsed.
+ */
+class tst_TagIndex : public QObject
+{
+    Q_OBJECT
+//-Class Variables-----------------------------------------------------------------------------------------------
+private:
+    static constexpr quint32 CONTAINER_SPAN = 0x10000;
+
+    // Fixture tags
+    enum FixtureTag { Puzzle = 1, Extreme, Multiplayer, QAndA, RockMusic, PointAndClick, Unused };
+
+//-Instance Variables-----------------------------------------------------------------------------------------------
+private:
+    std::optional<TagIndex> mIndex;
+
+//-Class Functions------------------------------------------------------------------------------------------------------
+private:
+    static QList<quint32> randomOrdinals(QRandomGenerator& generator, int count, quint32 low, quint32 high)
+    {
+        QSet<quint32> ordinals;
+        while(ordinals.size() < count)
+            ordinals.insert(low + generator.bounded(high - low));
+
+        QList<quint32> sorted(ordinals.cbegin(), ordinals.cend());
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }
+
+    static QList<quint32> sorted(const QSet<quint32>& set)
+    {
+        QList<quint32> list(set.cbegin(), set.cend());
+        std::sort(list.begin(), list.end());
+        return list;
+    }
+
+    static QSet<quint32> toSet(const QList<quint32>& list) { return QSet<quint32>(list.cbegin(), list.cend()); }
+
+    static QUuid gameId(quint32 ordinal) { return QUuid(ordinal + 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0); }
+
+    static void compareSet(const GameSet& actual, const QSet<quint32>& expected)
+    {
+        QCOMPARE(actual.toList(), sorted(expected));
+        QCOMPARE(actual.cardinality(), expected.size());
+        QCOMPARE(actual.isEmpty(), expected.isEmpty());
+    }
+
+private slots:
+    void initTestCase()
+    {
+        /* Ordinal: tags
+         * 0: Puzzle
+         * 1: Puzzle, Extreme
+         * 2: Puzzle, Multiplayer
+         * 3: Extreme, Multiplayer, Point and Click
+         * 4: Q AND A
+         * 5: Puzzle, Rock (Music)
+         */
+        QList<QUuid> games;
+        for(quint32 o = 0; o < 6; o++)
+            games.append(gameId(o));
+
+        QList<Db::Tag> tags{
+            {Puzzle, u"Puzzle"_s, u"Genre"_s},
+            {Extreme, u"Extreme"_s, u"Content Tags"_s},
+            {Multiplayer, u"Multiplayer"_s, u"Features"_s},
+            {QAndA, u"Q AND A"_s, u"Features"_s},
+            {RockMusic, u"Rock (Music)"_s, u"Genre"_s},
+            {PointAndClick, u"Point and Click"_s, u"Genre"_s},
+            {Unused, u"Unused"_s, u"Misc"_s}
+        };
+
+        QList<std::pair<QUuid, int>> gameTags{
+            {gameId(0), Puzzle},
+            {gameId(1), Puzzle}, {gameId(1), Extreme},
+            {gameId(2), Puzzle}, {gameId(2), Multiplayer},
+            {gameId(3), Extreme}, {gameId(3), Multiplayer}, {gameId(3), PointAndClick},
+            {gameId(4), QAndA},
+            {gameId(5), Puzzle}, {gameId(5), RockMusic}
+        };
+
+        mIndex = Fp::TestAccess::makeTagIndex(games, tags, gameTags);
+    }
+
+    void setOperations_data()
+    {
+        QTest::addColumn<int>("countA");
+        QTest::addColumn<quint32>("lowA");
+        QTest::addColumn<quint32>("highA");
+        QTest::addColumn<int>("countB");
+        QTest::addColumn<quint32>("lowB");
+        QTest::addColumn<quint32>("highB");
+
+        // Array limit is 4096 values per container
+        QTest::newRow("arrays") << 1000 << 0u << CONTAINER_SPAN << 1500 << 0u << CONTAINER_SPAN;
+        QTest::newRow("array union over limit") << 3000 << 0u << CONTAINER_SPAN << 3000 << 0u << CONTAINER_SPAN;
+        QTest::newRow("bitmaps") << 30000 << 0u << CONTAINER_SPAN << 40000 << 0u << CONTAINER_SPAN;
+        QTest::newRow("bitmap intersection back to array") << 8000 << 0u << CONTAINER_SPAN << 8000 << 0u << CONTAINER_SPAN;
+        QTest::newRow("bitmap and array") << 50000 << 0u << CONTAINER_SPAN << 2000 << 0u << CONTAINER_SPAN;
+        QTest::newRow("array and bitmap") << 2000 << 0u << CONTAINER_SPAN << 50000 << 0u << CONTAINER_SPAN;
+        QTest::newRow("several containers") << 20000 << 0u << 4 * CONTAINER_SPAN << 100000 << 0u << 4 * CONTAINER_SPAN;
+        QTest::newRow("disjoint containers") << 5000 << 0u << 2 * CONTAINER_SPAN << 5000 << 3 * CONTAINER_SPAN << 5 * CONTAINER_SPAN;
+        QTest::newRow("above one container") << 70000 << CONTAINER_SPAN << 3 * CONTAINER_SPAN << 6000 << 2 * CONTAINER_SPAN << 3 * CONTAINER_SPAN;
+        QTest::newRow("one empty") << 0 << 0u << 1u << 5000 << 0u << 2 * CONTAINER_SPAN;
+    }
+
+    void setOperations()
+    {
+        QFETCH(int, countA);
+        QFETCH(quint32, lowA);
+        QFETCH(quint32, highA);
+        QFETCH(int, countB);
+        QFETCH(quint32, lowB);
+        QFETCH(quint32, highB);
+
+        QRandomGenerator generator(static_cast<quint32>(qHash(QByteArray(QTest::currentDataTag()))));
+        QList<quint32> listA = randomOrdinals(generator, countA, lowA, highA);
+        QList<quint32> listB = randomOrdinals(generator, countB, lowB, highB);
+        GameSet a = GameSet::fromSorted(listA);
+        GameSet b = GameSet::fromSorted(listB);
+        QSet<quint32> setA = toSet(listA);
+        QSet<quint32> setB = toSet(listB);
+
+        compareSet(a, setA);
+        compareSet(a & b, QSet<quint32>(setA).intersect(setB));
+        compareSet(a | b, QSet<quint32>(setA).unite(setB));
+        compareSet(a - b, QSet<quint32>(setA).subtract(setB));
+        compareSet(b - a, QSet<quint32>(setB).subtract(setA));
+
+        // Results feed further operations in expressions, so they must still be well formed
+        compareSet((a | b) - (a & b), QSet<quint32>(setA).unite(setB).subtract(QSet<quint32>(setA).intersect(setB)));
+
+        for(quint32 probe : randomOrdinals(generator, 500, 0, std::max(highA, highB) + 1))
+            QCOMPARE(a.contains(probe), setA.contains(probe));
+    }
+
+    void range_data()
+    {
+        QTest::addColumn<quint32>("count");
+
+        // Word and container boundaries
+        for(quint32 count : {0u, 1u, 63u, 64u, 65u, 4096u, 4097u, CONTAINER_SPAN - 1, CONTAINER_SPAN, CONTAINER_SPAN + 1, 2 * CONTAINER_SPAN + 100})
+            QTest::addRow("%u", count) << count;
+    }
+
+    void range()
+    {
+        QFETCH(quint32, count);
+
+        GameSet all = GameSet::range(count);
+        QList<quint32> expected(count);
+        std::iota(expected.begin(), expected.end(), 0u);
+
+        QCOMPARE(all.toList(), expected);
+        QCOMPARE(all.cardinality(), qsizetype(count));
+        QVERIFY(!all.contains(count));
+        if(count > 0)
+            QVERIFY(all.contains(count - 1));
+
+        // Complement, as used by NOT
+        QRandomGenerator generator(count);
+        QList<quint32> some = count > 0 ? randomOrdinals(generator, std::min(count, 3000u), 0, count) : QList<quint32>();
+        compareSet(all - GameSet::fromSorted(some), toSet(expected).subtract(toSet(some)));
+    }
+
+    void evaluate_data()
+    {
+        QTest::addColumn<QString>("expression");
+        QTest::addColumn<QList<quint32>>("expected");
+
+        QTest::newRow("exclusions") << u"Puzzle AND NOT Extreme AND NOT Multiplayer"_s << QList<quint32>{0, 5};
+        QTest::newRow("parentheses") << u"Puzzle AND NOT (Extreme OR Multiplayer)"_s << QList<quint32>{0, 5};
+        QTest::newRow("nested parentheses") << u"((Puzzle) AND (Extreme OR (Multiplayer)))"_s << QList<quint32>{1, 2};
+        QTest::newRow("case-insensitive names") << u"pUZZLE"_s << QList<quint32>{0, 1, 2, 5};
+        QTest::newRow("unquoted multi-word name") << u"Point and Click"_s << QList<quint32>{3};
+        QTest::newRow("quoted operator") << u"\"Q AND A\""_s << QList<quint32>{4};
+        QTest::newRow("quoted parentheses") << u"\"Rock (Music)\" OR \"Q AND A\""_s << QList<quint32>{4, 5};
+        QTest::newRow("category") << u"category:Genre"_s << QList<quint32>{0, 1, 2, 3, 5};
+        QTest::newRow("category quoted") << u"category:\"Content Tags\""_s << QList<quint32>{1, 3};
+        QTest::newRow("category multi-word") << u"category:Content Tags AND Multiplayer"_s << QList<quint32>{3};
+        QTest::newRow("AND over OR") << u"Extreme OR Puzzle AND Multiplayer"_s << QList<quint32>{1, 2, 3};
+        QTest::newRow("NOT over AND") << u"NOT Puzzle AND Extreme"_s << QList<quint32>{3};
+        QTest::newRow("NOT over OR") << u"NOT Puzzle OR Extreme"_s << QList<quint32>{1, 3, 4};
+        QTest::newRow("double NOT") << u"NOT NOT Extreme"_s << QList<quint32>{1, 3};
+        QTest::newRow("known tag without games") << u"Unused"_s << QList<quint32>{};
+        QTest::newRow("known category without games") << u"category:Misc"_s << QList<quint32>{};
+    }
+
+    void evaluate()
+    {
+        QFETCH(QString, expression);
+        QFETCH(QList<quint32>, expected);
+
+        GameSet result;
+        Fp::DbError error = mIndex->evaluate(result, expression);
+        QVERIFY2(!error.isValid(), qPrintable(error.cause()));
+        QCOMPARE(result.toList(), expected);
+    }
+
+    void evaluateError_data()
+    {
+        QTest::addColumn<QString>("expression");
+        QTest::addColumn<QString>("cause");
+
+        QTest::newRow("unknown tag") << u"Puzzle AND Missing"_s << u"The expression references an unknown tag: Missing"_s;
+        QTest::newRow("unknown category") << u"category:Nope"_s << u"The expression references an unknown tag category: Nope"_s;
+        QTest::newRow("unterminated quote") << u"\"Puzzle"_s << u"Tag expression contains an unterminated quote at position 0."_s;
+        QTest::newRow("unterminated later quote") << u"Puzzle AND \"Extreme"_s << u"Tag expression contains an unterminated quote at position 11."_s;
+        QTest::newRow("empty") << u""_s << u"Unexpected token '<end>' in tag expression at position 0."_s;
+        QTest::newRow("dangling operator") << u"Puzzle AND"_s << u"Unexpected token '<end>' in tag expression at position 10."_s;
+        QTest::newRow("doubled operator") << u"Puzzle OR OR Extreme"_s << u"Unexpected token 'OR' in tag expression at position 10."_s;
+        QTest::newRow("unclosed parenthesis") << u"(Puzzle"_s << u"Unexpected token '<end>' in tag expression at position 7."_s;
+        QTest::newRow("unopened parenthesis") << u"Puzzle) OR Extreme"_s << u"Unexpected token ')' in tag expression at position 6."_s;
+        QTest::newRow("missing operator") << u"Puzzle (Extreme)"_s << u"Unexpected token '(' in tag expression at position 7."_s;
+    }
+
+    void evaluateError()
+    {
+        QFETCH(QString, expression);
+        QFETCH(QString, cause);
+
+        GameSet result = GameSet::range(1);
+        Fp::DbError error = mIndex->evaluate(result, expression);
+        QCOMPARE(error.type(), Fp::DbError::InvalidExpression);
+        QCOMPARE(error.cause(), cause);
+        QVERIFY(result.isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_TagIndex)
+#include "tst_tagindex.moc"